@@ -13,4 +13,6 @@ using annadb::Query::Query;
 
 void insert_some_values(annadb::AnnaDB &connection, const std::string &collection_name);
 
+void bulk_insert_numbers(annadb::AnnaDB &connection, const std::string &collection_name, int count);
+
 #endif //ANNADB_DRIVER_EXAMPLE_INSERT_EXAMPLE_HPP
@@ -13,6 +13,15 @@ int main()
     
     std::cout << "###################################################\n";
     
+    {
+        annadb::AnnaDB con{"jondoe", "passwd1234", "0.0.0.0", 10001};
+        con.connect();
+        bulk_insert_numbers(con, "my_collection", 100000);
+        con.close();
+    }
+    
+    std::cout << "###################################################\n";
+    
     {
         annadb::AnnaDB con{"jondoe", "passwd1234", "0.0.0.0", 10001};
         con.connect();
@@ -11,16 +11,16 @@ void find_number(annadb::AnnaDB &connection, const std::string &collection_name,
     {
         std::cout << "Find query was successful send\n";
         
-        auto journal = result.value();
+        const auto &journal = result.value();
         // I expect only one object so that I would use `short` over `int`
         auto new_rows = journal.meta().rows<short>();
         
         std::cout << "Found: " << new_rows.value() << " rows.\n";
         
-        TySonCollectionObject new_ids = journal.data().get<TySonType::Objects>().value();
-        for (auto &val: new_ids.get<TySonType::Objects>(collection_name))
+        const auto &new_objects = journal.data().get<TySonType::Objects>().value();
+        for (const auto &[link, value]: new_objects.get<TySonType::Objects>(collection_name))
         {
-            std::cout << val.first << ": " << val.second << "\n";
+            std::cout << link << ": " << value << "\n";
         };
     }
     else
@@ -45,16 +45,16 @@ void find_number_limit(
     {
         std::cout << "Find query was successful send\n";
         
-        auto journal = result.value();
+        const auto &journal = result.value();
         // I expect only one object so that I would use `short` over `int`
         auto new_rows = journal.meta().rows<short>();
         
         std::cout << "Found: " << new_rows.value() << " rows.\n";
         
-        TySonCollectionObject new_ids = journal.data().get<TySonType::Objects>().value();
-        for (auto &val: new_ids.get<TySonType::Objects>(collection_name))
+        const auto &new_objects = journal.data().get<TySonType::Objects>().value();
+        for (const auto &[link, value]: new_objects.get<TySonType::Objects>(collection_name))
         {
-            std::cout << val.first << ": " << val.second << "\n";
+            std::cout << link << ": " << value << "\n";
         };
     }
     else
@@ -83,16 +83,16 @@ void find_number_limit_offset(
     {
         std::cout << "Find query was successful send\n";
         
-        auto journal = result.value();
+        const auto &journal = result.value();
         // I expect only one object so that I would use `short` over `int`
         auto new_rows = journal.meta().rows<short>();
         
         std::cout << "Found: " << new_rows.value() << " rows.\n";
         
-        TySonCollectionObject new_ids = journal.data().get<TySonType::Objects>().value();
-        for (auto &val: new_ids.get<TySonType::Objects>(collection_name))
+        const auto &new_objects = journal.data().get<TySonType::Objects>().value();
+        for (const auto &[link, value]: new_objects.get<TySonType::Objects>(collection_name))
         {
-            std::cout << val.first << ": " << val.second << "\n";
+            std::cout << link << ": " << value << "\n";
         };
     }
     else
@@ -25,14 +25,14 @@ void insert_some_values(annadb::AnnaDB &connection, const std::string &collectio
     {
         std::cout << "Insert query was successful\n";
         
-        auto journal = result.value();
+        const auto &journal = result.value();
         // I expect only a few new objects so that I would use `short` over `int`
         auto new_rows = journal.meta().rows<short>();
         
         std::cout << "Inserted: " << new_rows.value() << " new rows.\n";
         
-        TySonCollectionObject new_ids = journal.data().get<TySonType::IDs>().value();
-        for (auto &val: new_ids.get<TySonType::IDs>(collection_name))
+        const auto &new_ids = journal.data().get<TySonType::IDs>().value();
+        for (const auto &val: new_ids.get<TySonType::IDs>(collection_name))
         {
             std::cout << val << "\n";
         };
@@ -42,3 +42,25 @@ void insert_some_values(annadb::AnnaDB &connection, const std::string &collectio
         std::cout << "Something went wrong during the insertion\n";
     }
 }
+
+void bulk_insert_numbers(annadb::AnnaDB &connection, const std::string &collection_name, int count)
+{
+    std::vector<TYSON> numbers {};
+    numbers.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        numbers.push_back(TYSON::Number(i));
+    }
+    
+    // the numbers are sent in chunks which grow as long as AnnaDB answers fast enough
+    auto result = connection.bulk_insert(collection_name, numbers);
+    if (result.ok)
+    {
+        std::cout << "Inserted: " << result.ids.size() << " new rows in " << result.chunks << " chunks, "
+                  << result.records_per_second() << " rows/s\n";
+    }
+    else
+    {
+        std::cout << "Something went wrong after " << result.records << " rows\n";
+    }
+}
@@ -6,8 +6,26 @@
 #define ANNADB_DRIVER_TYSON_HPP
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cctype>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include "TySON_index.hpp"
+#include "TySON_uuid.hpp"
 #include "utils.hpp"
 
 namespace tyson
@@ -78,151 +96,422 @@ namespace tyson
         return "";
     }
 
+    class TySonParser;
+    class Writer;
+
+    /**
+     * A value which is built on the first access of a const object.
+     * The build is guarded by a std::once_flag, so concurrent const reads build it exactly once.
+     * A copy does not share the built value, it is built again on its first access.
+     *
+     * @tparam T the built value
+     */
+    template<typename T>
+    class Lazy
+    {
+        mutable std::once_flag once_ {};
+        mutable std::optional<T> value_ {};
+
+    public:
+        Lazy() = default;
+
+        Lazy(const Lazy &) noexcept {}
+
+        Lazy& operator=(const Lazy &other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+            }
+            return *this;
+        }
+
+        ~Lazy() = default;
+
+        /**
+         *
+         * @param build creates the value, it is only called by the first access
+         * @return the built value, valid until reset or the destruction of this object
+         */
+        template<typename Build>
+        const T& get(Build &&build) const
+        {
+            std::call_once(once_, [this, &build] { value_.emplace(build()); });
+            return *value_;
+        }
+
+        /**
+         * Forget the built value, it must not be called while the value is read
+         */
+        void reset() noexcept
+        {
+            value_.reset();
+            std::destroy_at(&once_);
+            std::construct_at(&once_);
+        }
+    };
+
+    /**
+     * Interning table for the collection names of links.
+     * Every link of a response points to one shared copy of its collection name,
+     * so `test_journal` is stored once instead of once per link.
+     * A response only names a few collections, they are searched one by one.
+     */
+    class CollectionNames
+    {
+    public:
+        using name_type = std::shared_ptr<const std::pmr::string>;
+
+    private:
+        std::vector<name_type> names_ {};
+        std::size_t last_ = 0;
+
+    public:
+        /**
+         * Get the shared copy of a collection name, it is created on the first use
+         *
+         * @param name the collection name
+         * @param alloc the memory of a new name comes from it, names of other allocators are not shared
+         * @return the shared name
+         */
+        [[nodiscard]] name_type intern(std::string_view name, const std::pmr::polymorphic_allocator<> &alloc)
+        {
+            // links of one collection mostly follow each other
+            if (last_ < names_.size() && *names_[last_] == name && names_[last_]->get_allocator() == alloc)
+            {
+                return names_[last_];
+            }
+
+            for (last_ = 0; last_ < names_.size(); ++last_)
+            {
+                if (*names_[last_] == name && names_[last_]->get_allocator() == alloc)
+                {
+                    return names_[last_];
+                }
+            }
+            return names_.emplace_back(make(name, alloc));
+        }
+
+        /**
+         * Create a name which is not shared with any other one
+         */
+        [[nodiscard]] static name_type make(std::string_view name, const std::pmr::polymorphic_allocator<> &alloc)
+        {
+            return std::allocate_shared<std::pmr::string>(alloc, name);
+        }
+
+        /**
+         *
+         * @return number of different collection names
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return names_.size();
+        }
+    };
+
     /**
      * The TySonObject class which is the base of all TySON types
      * @see <a href="https://annadb.dev/documentation/data_types/">AnnaDB data types</a>
      */
     class TySonObject
     {
-        std::vector<TySonObject> vector_{};
-        std::map<TySonObject, TySonObject> map_{};
-        std::pair<std::string, std::string> link_{};
-        TySonType type_;
-        std::string value_;
+    public:
+        /**
+         * All memory of a TySonObject and its nested values comes from this allocator,
+         * so a whole response can be parsed into one std::pmr::monotonic_buffer_resource
+         */
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    private:
+        using string_type = std::pmr::string;
+        using vector_type = std::pmr::vector<TySonObject>;
+        // a flat map, the entries are sorted by their key and every key exists once
+        using map_type = std::pmr::vector<std::pair<TySonObject, TySonObject>>;
 
         /**
-         * Parse a AnnaDB(TySON) Vector into a std::vector<TySonObject>
-         * AnnaDB(TySON) Vector example:
-         * v[n|1|,n|2|,n|3|,]
-         *
-         * @param object string_view the raw string of a AnnaDB(TySON) Vector
-         * @see Tyson.tyson::TySonObject
+         * A Link with a uuid as object id, the uuid is only formatted again if it is written.
+         * The collection name is shared with the other links of the same response
          */
-        void parse_vector_elements(std::string_view object) noexcept
+        struct link_type
         {
-            const auto to_tyson_object = [](std::string &val) -> TySonObject
+            CollectionNames::name_type collection;
+            Uuid id;
+
+            link_type(CollectionNames::name_type collection_name, const Uuid &uuid) noexcept
+                : collection(std::move(collection_name)), id(uuid)
+            {}
+
+            // the name is only shared if its memory comes from the same allocator
+            link_type(const link_type &other, const allocator_type &alloc)
+                : collection(other.collection->get_allocator() == alloc ? other.collection
+                                                                        : CollectionNames::make(*other.collection, alloc)),
+                  id(other.id)
+            {}
+
+            link_type(const link_type &) = default;
+            link_type(link_type &&) noexcept = default;
+            link_type& operator=(const link_type &) = default;
+            link_type& operator=(link_type &&) noexcept = default;
+
+            bool operator==(const link_type &other) const noexcept
             {
-                return TySonObject{val};
-            };
+                return id == other.id && (collection == other.collection || *collection == *other.collection);
+            }
+
+            std::strong_ordering operator<=>(const link_type &other) const noexcept
+            {
+                if (collection != other.collection)
+                {
+                    if (auto order = *collection <=> *other.collection; order != 0)
+                    {
+                        return order;
+                    }
+                }
+                return id <=> other.id;
+            }
+        };
+
+        using data_type = std::variant<std::monostate, string_type, vector_type, map_type,
+                                       std::int64_t, std::uint64_t, double, bool, link_type>;
+
+        /*
+         * Only the active alternative is stored:
+         *      Null                     => std::monostate
+         *      Number, Timestamp        => std::int64_t, std::uint64_t above INT64_MAX or double,
+         *                                  the string if it is no valid number
+         *      Bool                     => bool
+         *      String, Keep             => the value as string, short ones stay inside of the object
+         *      Link                     => link_type with an interned collection name,
+         *                                  `collection|id` as one string if the id is no uuid
+         *      Vector                   => vector_type
+         *      Map, Value, ProjectValue => map_type
+         */
+        data_type data_ {};
+        TySonType type_;
+        allocator_type alloc_ {};
 
-            auto end_type_sep = object.find_first_of('[') + 1;
-            auto end_value_sep = (object.size() - 1) - end_type_sep;
+        friend class TySonParser;
+        friend class Writer;
+
+        /**
+         * Copy the value with another allocator, nested values are copied with it as well
+         */
+        [[nodiscard]] static data_type copy_data(const data_type &data, const allocator_type &alloc)
+        {
+            return std::visit([&alloc](const auto &value) -> data_type
+                              {
+                                  using T = std::decay_t<decltype(value)>;
+                                  if constexpr (std::is_same_v<T, std::monostate> || std::is_arithmetic_v<T>)
+                                  {
+                                      return value;
+                                  }
+                                  else
+                                  {
+                                      return data_type {std::in_place_type<T>, value, alloc};
+                                  }
+                              }, data);
+        }
 
-            auto vector_data = object.substr(end_type_sep, end_value_sep);
+        [[nodiscard]] std::string_view str() const noexcept
+        {
+            const auto *str = std::get_if<string_type>(&data_);
+            return str ? std::string_view {*str} : std::string_view {};
+        }
 
-            auto vec_data = utils::split(vector_data, ',');
-            std::transform(vec_data.begin(), vec_data.end(), std::back_inserter(vector_), to_tyson_object);
+        void set_str(std::string_view value)
+        {
+            data_.emplace<string_type>(value, alloc_);
         }
 
         /**
-         * Parse AnnaDB(TySON) Map values into a std::vector<TySonObject>
-         * AnnaDB(TySON) Map example:
-         * m{ s|bar|: s|baz|,}
+         * Store an integral number, unsigned ones are only kept as std::uint64_t if they do not fit into std::int64_t
+         */
+        template<typename T>
+        requires std::is_integral_v<T>
+        void set_integral(T number) noexcept
+        {
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                if (static_cast<std::uint64_t>(number) > static_cast<std::uint64_t>(INT64_MAX))
+                {
+                    data_.emplace<std::uint64_t>(number);
+                    return;
+                }
+            }
+            data_.emplace<std::int64_t>(static_cast<std::int64_t>(number));
+        }
+
+        /**
+         * Parse the text of a Number or Timestamp once into its native representation
          *
-         * @param object string_view the raw string of a AnnaDB(TySON) Map
-         * @return the inner elements of a TySON Map parsed into a TySonObject
-         * @see Tyson.tyson::TySonObject
+         * @param value the text between the `|`
          */
-        [[ nodiscard ]] std::vector<TySonObject> parse_map_element(std::string_view object) noexcept
+        void set_number(std::string_view value)
         {
-            const auto to_tyson_object = [](std::string &val) -> TySonObject
+            const auto *begin = value.data();
+            const auto *end = begin + value.size();
+
+            std::int64_t int_value {};
+            auto int_result = std::from_chars(begin, end, int_value);
+            if (int_result.ec == std::errc() && int_result.ptr == end)
             {
-                return TySonObject{val};
-            };
+                data_.emplace<std::int64_t>(int_value);
+                return;
+            }
 
-            auto vec_data = utils::split(object, ':');
+            std::uint64_t uint_value {};
+            auto uint_result = std::from_chars(begin, end, uint_value);
+            if (uint_result.ec == std::errc() && uint_result.ptr == end)
+            {
+                data_.emplace<std::uint64_t>(uint_value);
+                return;
+            }
 
-            std::vector<TySonObject> result;
-            result.reserve(vec_data.size());
+            double double_value {};
+            auto double_result = std::from_chars(begin, end, double_value);
+            if (double_result.ec == std::errc() && double_result.ptr == end)
+            {
+                data_.emplace<double>(double_value);
+                return;
+            }
 
-            std::transform(vec_data.begin(), vec_data.end(), std::back_inserter(result), to_tyson_object);
-            return result;
+            // not a number AnnaDB would send, keep it as it is
+            set_str(value);
         }
 
         /**
-         * Parse AnnaDB(TySON) Map into a std::vector<TySonObject>
-         * AnnaDB(TySON) Map example:
-         * m{ s|bar|: s|baz|,}
+         * The value as it is written inside of the `|`,
+         * doubles use the shortest representation which parses back to the same value
          *
-         * @param object string_view the raw string of a AnnaDB(TySON) Map
-         * @see Tyson.tyson::TySonObject
+         * @return the text of the value
          */
-        void parse_map_elements(std::string_view object) noexcept
+        [[nodiscard]] std::string text() const
+        {
+            return std::visit([this](const auto &value) -> std::string
+                              {
+                                  using T = std::decay_t<decltype(value)>;
+                                  if constexpr (std::is_same_v<T, bool>)
+                                  {
+                                      return value ? "true" : "false";
+                                  }
+                                  else if constexpr (std::is_arithmetic_v<T>)
+                                  {
+                                      char buffer[32];
+                                      auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                                      return {buffer, ptr};
+                                  }
+                                  else
+                                  {
+                                      return std::string(str());
+                                  }
+                              }, data_);
+        }
+
+        [[nodiscard]] const vector_type& vec() const noexcept
         {
-            auto end_type_sep = object.find_first_of('{') + 1;
-            auto end_value_sep = (object.size() - 1) - end_type_sep;
-            auto map_data = object.substr(end_type_sep, end_value_sep);
+            static const vector_type empty {};
+            const auto *vec = std::get_if<vector_type>(&data_);
+            return vec ? *vec : empty;
+        }
 
-            auto vec_data = utils::split(map_data, ',');
+        [[nodiscard]] const map_type& map() const noexcept
+        {
+            static const map_type empty {};
+            const auto *map = std::get_if<map_type>(&data_);
+            return map ? *map : empty;
+        }
 
-            auto to_map_element = [this](auto &val) -> std::vector<TySonObject>
+        map_type& map_data() noexcept
+        {
+            if (!std::holds_alternative<map_type>(data_))
             {
-                return parse_map_element(val);
-            };
+                data_.emplace<map_type>(alloc_);
+            }
+            return std::get<map_type>(data_);
+        }
 
-            std::vector<std::vector<TySonObject>> result;
-            std::transform(vec_data.begin(), vec_data.end(), std::back_inserter(result), to_map_element);
-            std::for_each(result.begin(), result.end(), [this](auto key_val)
+        /**
+         * Insert an entry at its sorted position if the key does not exist yet
+         *
+         * @return true if inserted
+         */
+        bool insert_entry(TySonObject key, TySonObject value)
+        {
+            auto &map = map_data();
+            auto pos = std::lower_bound(map.begin(), map.end(), key,
+                                        [](const auto &entry, const TySonObject &new_key)
+                                        {
+                                            return entry.first < new_key;
+                                        });
+            if (pos != map.end() && pos->first == key)
             {
-                map_.try_emplace(key_val[0], key_val[1]);
-            });
+                return false;
+            }
+            map.emplace(pos, std::move(key), std::move(value));
+            return true;
         }
 
         /**
-         * @return the string representation of the current TySON object in it's special format
-         * @example: TySON::Number(5) => n|5|
+         * Sort the entries of a parsed map by their key, the first one of equal keys is kept
          */
-        friend std::ostream& operator<<(std::ostream &out, TySonObject const &obj) noexcept
+        static void sort_entries(map_type &map)
         {
-            switch (obj.type())
+            const auto by_key = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+            if (!std::is_sorted(map.begin(), map.end(), by_key))
             {
-                case TySonType::Number:
-                    return out << "n|" << obj.value_ << "|";
-                case TySonType::String:
-                    return out << "s|" << obj.value_ << "|";
-                case TySonType::Bool:
-                    return out << "b|" << obj.value_ << "|";
-                case TySonType::Null:
-                    return out << "null";
-                case TySonType::Timestamp:
-                    return out << "utc|" << obj.value_ << "|";
-                case TySonType::Link:
-                    return out << std::get<0>(obj.link_) << "|" << std::get<1>(obj.link_) << "|";
-                case TySonType::Value:
-                    return out << "value|" << obj.map_.begin()->first.value_ << "|:" << obj.map_.begin()->second;
-                case TySonType::Vector:
-                {
-                    std::stringstream sstream;
-                    std::for_each(obj.vector_.begin(),
-                                  obj.vector_.end(),
-                                  [&sstream](const auto &val){ sstream << val << ","; });
+                std::stable_sort(map.begin(), map.end(), by_key);
+            }
+            map.erase(std::unique(map.begin(), map.end(),
+                                  [](const auto &lhs, const auto &rhs) { return lhs.first == rhs.first; }),
+                      map.end());
+        }
 
-                    return out << "v[" << sstream.str() << "]";
-                }
-                case TySonType::Map:
-                {
-                    std::stringstream sstream;
-                    std::for_each(obj.map_.begin(),
-                                  obj.map_.end(),
-                                  [&sstream](const std::pair<TySonObject, TySonObject> &val)
-                                  {
-                                        sstream << val.first << ":" << val.second << ",";
-                                  });
+        /**
+         * Store a Link, the id is kept as 16 bytes if it is a uuid
+         *
+         * @param collection the name of the reference collection
+         * @param id the id of the element inside of the collection
+         * @param names shares the collection name with other links, a new name is created without it
+         */
+        void set_link(std::string_view collection, std::string_view id, CollectionNames *names = nullptr)
+        {
+            if (auto uuid = Uuid::parse(id))
+            {
+                data_.emplace<link_type>(names ? names->intern(collection, alloc_)
+                                               : CollectionNames::make(collection, alloc_), *uuid);
+                return;
+            }
 
-                    return out << "m{" << sstream.str() << "}";
-                }
-                case TySonType::ProjectValue:
-                {
-                    return out << "value|" << obj.map_.begin()->first.value_ << "|";
-                }
-                case TySonType::Keep:
-                {
-                    return out << "keep";
-                }
-                default:
-                    return out << "";
+            auto &link = data_.emplace<string_type>(alloc_);
+            link.reserve(collection.size() + 1 + id.size());
+            link.append(collection).append(1, '|').append(id);
+        }
+
+        /**
+         * The collection name and the id of a Link, the uuid is formatted here
+         */
+        [[nodiscard]] std::pair<std::string, std::string> link() const
+        {
+            if (const auto *link = std::get_if<link_type>(&data_))
+            {
+                return {std::string(*link->collection), link->id.str()};
+            }
+
+            auto text = str();
+            auto separator = text.find('|');
+            if (separator == std::string_view::npos)
+            {
+                return {std::string(text), {}};
             }
+            return {std::string(text.substr(0, separator)), std::string(text.substr(separator + 1))};
         }
+
+        /**
+         * @return the string representation of the current TySON object in it's special format
+         * @example: TySON::Number(5) => n|5|
+         */
+        friend std::ostream& operator<<(std::ostream &out, TySonObject const &obj) noexcept;
         
         /**
          * Helper method to cast char to TySonType if necessary.
@@ -232,7 +521,7 @@ namespace tyson
          * @see <a href="https://annadb.dev/documentation/data_types/">AnnaDB data types</a>
          * @return TySonType
          */
-        TySonType cast_type_string(char &_type)
+        static TySonType cast_type_string(char _type) noexcept
         {
             switch (_type)
             {
@@ -258,54 +547,71 @@ namespace tyson
     public:
 
         TySonObject() noexcept : type_(tyson::TySonType::Null) {};
-        ~TySonObject() = default;
 
         /**
-         * Create a new TySonObject from a raw AnnaDB data type string
+         * Create a new Null TySonObject which allocates its values with alloc
          *
-         * @param object representing a AnnaDB data type
-         * @see <a href="https://annadb.dev/documentation/data_types/">AnnaDB data types</a>
+         * @param alloc used for this and all nested values
+         */
+        explicit TySonObject(const allocator_type &alloc) noexcept : type_(tyson::TySonType::Null), alloc_(alloc) {};
+
+        /**
+         * Copies use the default memory resource like all std::pmr containers
+         */
+        TySonObject(const TySonObject &other) : TySonObject(other, allocator_type {}) {}
+
+        TySonObject(const TySonObject &other, const allocator_type &alloc) : data_(copy_data(other.data_, alloc)),
+                                                                             type_(other.type_), alloc_(alloc)
+        {}
+
+        TySonObject(TySonObject &&) noexcept = default;
+
+        /**
+         * Move if both use the same memory resource, copy otherwise
          */
-        explicit TySonObject(std::string_view object) noexcept
+        TySonObject(TySonObject &&other, const allocator_type &alloc) : type_(other.type_), alloc_(alloc)
         {
-            auto end_type_sep = object.find_first_of('|');
-            auto end_value_sep = (object.size() - 1) - (end_type_sep + 1);
-            auto type = object.substr(0, end_type_sep);
+            data_ = alloc_ == other.alloc_ ? std::move(other.data_) : copy_data(other.data_, alloc_);
+        }
 
-            if (object == "null")
+        /**
+         * The allocator is not replaced by assignments
+         */
+        TySonObject& operator=(const TySonObject &other)
+        {
+            if (this != &other)
             {
-                type_ = TySonType::Null;
-                value_ = {};
-                return;
+                data_ = copy_data(other.data_, alloc_);
+                type_ = other.type_;
             }
+            return *this;
+        }
 
-            if (object.starts_with("uts"))
-            {
-                type_ = TySonType::Timestamp;
-                value_ = object.substr(end_type_sep + 1, end_value_sep);
-            }
-            else if (object.substr(0, 2) == "v[")
-            {
-                type_ = TySonType::Vector;
+        TySonObject& operator=(TySonObject &&other)
+        {
+            data_ = alloc_ == other.alloc_ ? std::move(other.data_) : copy_data(other.data_, alloc_);
+            type_ = other.type_;
+            return *this;
+        }
 
-                parse_vector_elements(object);
-            }
-            else if (object.substr(0, 2) == "m{")
-            {
-                type_ = TySonType::Map;
-                parse_map_elements(object);
-            }
-            else if (end_type_sep > 1)
-            {
-                type_ = TySonType::Link;
-                auto val = object.substr(end_type_sep + 1, end_value_sep);
-                link_ = std::make_pair(type, val);
-            }
-            else
-            {
-                type_ = cast_type_string(const_cast<char &>(type.at(0)));
-                value_ = object.substr(end_type_sep + 1, end_value_sep);
-            }
+        ~TySonObject() = default;
+
+        /**
+         * Create a new TySonObject from a raw AnnaDB data type string
+         *
+         * @param object representing a AnnaDB data type
+         * @param alloc used for the parsed value and all nested values
+         * @see <a href="https://annadb.dev/documentation/data_types/">AnnaDB data types</a>
+         */
+        explicit TySonObject(std::string_view object, const allocator_type &alloc = {}) noexcept;
+
+        /**
+         *
+         * @return the allocator of this TySonObject
+         */
+        [[nodiscard]] allocator_type get_allocator() const noexcept
+        {
+            return alloc_;
         }
 
         /**
@@ -315,8 +621,7 @@ namespace tyson
          */
         [[ nodiscard ]] bool operator==(const TySonObject &rhs) const noexcept
         {
-            return std::tie(this->type_, this->value_, this->vector_, this->map_, this->link_) ==
-                   std::tie(rhs.type_, rhs.value_, rhs.vector_, rhs.map_, rhs.link_);
+            return std::tie(this->type_, this->data_) == std::tie(rhs.type_, rhs.data_);
         }
     
         /**
@@ -326,7 +631,7 @@ namespace tyson
          */
         [[ nodiscard ]] bool operator<(const TySonObject &rhs) const noexcept
         {
-            return std::tie(this->type_, this->value_, this->vector_) < std::tie(rhs.type_, rhs.value_, rhs.vector_);
+            return std::tie(this->type_, this->data_) < std::tie(rhs.type_, rhs.data_);
         }
         
         /**
@@ -344,8 +649,7 @@ namespace tyson
                 sstream << TySonType_repr(type_);
                 throw std::invalid_argument(sstream.str());
             }
-            const auto [it, success]  = map_.try_emplace(TySonObject::String(key), std::move(value));
-            return success;
+            return insert_entry(TySonObject::String(key), std::move(value));
         }
 
         /**
@@ -360,7 +664,25 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Number(T number) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = std::to_string(number);
+            tySonObject.set_integral(number);
+            tySonObject.type_ = TySonType::Number;
+            return tySonObject;
+        }
+
+        /**
+         * Create a new TySonObject Number from a floating point value,
+         * it is written with the shortest representation which parses back to the same value
+         *
+         * @tparam T a floating point type
+         * @param number the value of the new TySonObject
+         * @return new TySonObject
+         */
+        template<typename T>
+        requires std::is_floating_point_v<T>
+        [[ nodiscard ]] static TySonObject Number(T number) noexcept
+        {
+            TySonObject tySonObject {};
+            tySonObject.data_.emplace<double>(static_cast<double>(number));
             tySonObject.type_ = TySonType::Number;
             return tySonObject;
         }
@@ -375,7 +697,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject String(const std::string &str) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = str;
+            tySonObject.set_str(str);
             tySonObject.type_ = TySonType::String;
             return tySonObject;
         }
@@ -389,7 +711,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Bool(bool bl) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = bl ? "true" : "false";
+            tySonObject.data_.emplace<bool>(bl);
             tySonObject.type_ = TySonType::Bool;
             return tySonObject;
         }
@@ -402,7 +724,6 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Null() noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = "null";
             tySonObject.type_ = TySonType::Null;
             return tySonObject;
         }
@@ -415,7 +736,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Keep() noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = "keep";
+            tySonObject.set_str("keep");
             tySonObject.type_ = TySonType::Keep;
             return tySonObject;
         }
@@ -430,7 +751,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Timestamp(unsigned long long seconds) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.value_ = std::to_string(seconds);
+            tySonObject.set_integral(seconds);
             tySonObject.type_ = TySonType::Timestamp;
             return tySonObject;
         }
@@ -445,7 +766,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Link(const std::string &collection, const std::string &uuid) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.link_ = {collection, uuid};
+            tySonObject.set_link(collection, uuid);
             tySonObject.type_ = TySonType::Link;
             return tySonObject;
         }
@@ -460,8 +781,9 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Vector(Values &&...objs) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.vector_.reserve(sizeof ...(objs));
-            (tySonObject.vector_.emplace_back(objs), ...);
+            auto &vector = tySonObject.data_.emplace<vector_type>(tySonObject.alloc_);
+            vector.reserve(sizeof ...(objs));
+            (vector.emplace_back(objs), ...);
             tySonObject.type_ = TySonType::Vector;
             return tySonObject;
         }
@@ -476,7 +798,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Value(const std::string &field, TySonObject &&val) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.map_.try_emplace(TySonObject::String(field), val);
+            tySonObject.insert_entry(TySonObject::String(field), val);
             tySonObject.type_ = TySonType::Value;
             return tySonObject;
         }
@@ -490,7 +812,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject ProjectValue(const std::string &value) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.map_.try_emplace(TySonObject::String(value), value);
+            tySonObject.insert_entry(TySonObject::String(value), TySonObject(value));
             tySonObject.type_ = TySonType::ProjectValue;
             return tySonObject;
         }
@@ -507,7 +829,7 @@ namespace tyson
             std::for_each(objs.begin(), objs.end(),
                           [&tySonObject](std::pair<const std::string, TySonObject> &val)
                           {
-                                tySonObject.map_.try_emplace(TySonObject::String(val.first), std::move(val.second));
+                                tySonObject.insert_entry(TySonObject::String(val.first), std::move(val.second));
                           });
             tySonObject.type_ = TySonType::Map;
             return tySonObject;
@@ -523,7 +845,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Map(const std::string &key, TySonObject &&obj) noexcept
         {
             TySonObject tySonObject {};
-            tySonObject.map_.try_emplace(TySonObject::String(key), std::move(obj));
+            tySonObject.insert_entry(TySonObject::String(key), std::move(obj));
             tySonObject.type_ = TySonType::Map;
             return tySonObject;
         }
@@ -537,6 +859,7 @@ namespace tyson
         [[ nodiscard ]] static TySonObject Map() noexcept
         {
             TySonObject tySonObject {};
+            tySonObject.data_.emplace<map_type>(tySonObject.alloc_);
             tySonObject.type_ = TySonType::Map;
             return tySonObject;
         }
@@ -549,163 +872,1712 @@ namespace tyson
          */
         [[ nodiscard ]] std::optional<TySonObject> operator[](const std::string_view key) const noexcept
         {
-            if (type_ == TySonType::Map)
-            {
-                TySonObject result;
-                std::for_each(map_.begin(),
-                              map_.end(),
-                              [&result, &key](const std::pair<TySonObject, TySonObject> &obj)
-                              {
-                                  if (obj.first.value_ == key)
-                                  {
-                                      result = obj.second;
-                                  }
-                              });
-                return result;
-            }
-            else
+            const auto *value = find(key);
+            if (value)
             {
-                return {};
+                return *value;
             }
+            return {};
         }
 
         /**
+         * Find the value of a AnnaDB Map entry without copying it,
+         * the keys are sorted so this is a binary search
          *
-         * @return the type name of the current TysonObject
+         * @param key the value of a String key, exampl.: `bar` for s|bar|
+         * @return the value or nullptr if this is no Map or the key does not exist
+         */
+        [[nodiscard]] const TySonObject* find(std::string_view key) const noexcept
+        {
+            if (type_ != TySonType::Map)
+            {
+                return nullptr;
+            }
+
+            const auto &entries = map();
+            auto pos = std::lower_bound(entries.begin(), entries.end(), key,
+                                        [](const auto &entry, std::string_view search)
+                                        {
+                                            if (entry.first.type_ != TySonType::String)
+                                            {
+                                                return entry.first.type_ < TySonType::String;
+                                            }
+                                            return entry.first.str() < search;
+                                        });
+
+            if (pos != entries.end() && pos->first.type_ == TySonType::String && pos->first.str() == key)
+            {
+                return &pos->second;
+            }
+            return nullptr;
+        }
+
+        /**
+         * Resolve a nested value by the keys of the Maps and the positions inside of the Vectors on the way
+         * exampl.: `a.b.1` for m{s|a|:m{s|b|:v[n|1|,n|2|,],},} is the TySonObject n|2|
+         *
+         * @param path the keys and positions separated by `.`
+         * @return the value or nullptr if the path does not exist
+         */
+        [[nodiscard]] const TySonObject* at_path(std::string_view path) const noexcept
+        {
+            const TySonObject *current = this;
+            while (current)
+            {
+                auto separator = path.find('.');
+                auto segment = path.substr(0, separator);
+
+                if (current->type_ == TySonType::Vector)
+                {
+                    std::size_t pos {};
+                    auto [ptr, ec] = std::from_chars(segment.data(), segment.data() + segment.size(), pos);
+                    const auto &vector = current->vec();
+                    current = ec == std::errc() && ptr == segment.data() + segment.size() && pos < vector.size()
+                              ? &vector[pos]
+                              : nullptr;
+                }
+                else
+                {
+                    current = current->find(segment);
+                }
+
+                if (separator == std::string_view::npos)
+                {
+                    break;
+                }
+                path.remove_prefix(separator + 1);
+            }
+            return current;
+        }
+
+        /**
+         * View the collection name of a Link without copying it
+         *
+         * @return the collection name, empty if it is no Link
+         */
+        [[nodiscard]] std::string_view link_collection() const noexcept
+        {
+            if (const auto *link = std::get_if<link_type>(&data_))
+            {
+                return *link->collection;
+            }
+            if (type_ != TySonType::Link)
+            {
+                return {};
+            }
+
+            auto text = str();
+            return text.substr(0, text.find('|'));
+        }
+
+        /**
+         *
+         * @return the binary uuid of a Link, empty if it is no Link or its id is no uuid
+         */
+        [[nodiscard]] std::optional<Uuid> link_uuid() const noexcept
+        {
+            if (const auto *link = std::get_if<link_type>(&data_))
+            {
+                return link->id;
+            }
+            return {};
+        }
+
+        /**
+         *
+         * @return the type name of the current TysonObject
          */
         [[nodiscard]] TySonType type() const noexcept
         {
-            return type_;
+            return type_;
+        }
+
+        /**
+         * Get the current value of the TySonObject
+         *
+         * @tparam T must be of type TySonType
+         * @return the current value representation
+         */
+        template<TySonType T>
+        [[nodiscard]] std::string value() const noexcept
+        {
+            return text();
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB Bool Primitive
+         *
+         * @tparam T TySonType::Bool
+         * @return true if it is a Bool with the value `true` false otherwise
+         */
+        template<TySonType T>
+        requires (T == TySonType::Bool)
+        [[nodiscard]] bool value() const noexcept
+        {
+            const auto *bl = std::get_if<bool>(&data_);
+            return bl && *bl;
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB null Primitive
+         *
+         * @tparam T TySonType::Null
+         * @return an empty string to indicate null
+         */
+        template<TySonType T>
+        requires (T == TySonType::Null)
+        [[nodiscard]] std::string value() const noexcept
+        {
+            return "";
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB Link Primitive
+         *
+         * @tparam T TySonType::Link
+         * @return collection name and object_id as uuid-string
+         */
+        template<TySonType T>
+        requires (T == TySonType::Link)
+        [[nodiscard]] std::pair<std::string, std::string> value() const noexcept
+        {
+            return link();
+        }
+
+        /**
+         * View the elements of a AnnaDB Vector without copying them
+         *
+         * exampl.: for (const auto &element : object.vector_items())
+         *
+         * @return the elements or an empty span if this is no Vector
+         */
+        [[nodiscard]] std::span<const TySonObject> vector_items() const noexcept
+        {
+            return vec();
+        }
+
+        /**
+         * View the entries of a AnnaDB Map without copying them, they are sorted by their key
+         *
+         * exampl.: for (const auto &[key, value] : object.map_items())
+         *
+         * @return the Key-Value pairs or an empty span if this is no Map
+         */
+        [[nodiscard]] std::span<const std::pair<TySonObject, TySonObject>> map_items() const noexcept
+        {
+            return map();
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB Vector,
+         * this copies every element, use vector_items() to only look at them
+         *
+         * @tparam T TySonType::Vector
+         * @return vector of TySonObjects
+         */
+        template<TySonType T>
+        requires (T == TySonType::Vector)
+        [[nodiscard]] std::vector<TySonObject> value() const noexcept
+        {
+            return {vec().begin(), vec().end()};
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB Map,
+         * this copies every entry, use map_items() or find() to only look at them
+         *
+         * @tparam T TySonType::Map
+         * @return Key-Value pairs of TySonObjects
+         */
+        template<TySonType T>
+        requires (T == TySonType::Map)
+        [[nodiscard]] std::map<TySonObject, TySonObject> value() const noexcept
+        {
+            return {map().begin(), map().end()};
+        }
+
+        /**
+         * Convert a stored number into the requested type without truncating or wrapping it,
+         * a double converted into an integer only drops its fraction
+         *
+         * @throw out_of_range if the value does not fit into T
+         */
+        template<typename T, typename S>
+        [[nodiscard]] static T convert_number(S number)
+        {
+            if constexpr (std::is_integral_v<T> && std::is_integral_v<S>)
+            {
+                if (!std::in_range<T>(number))
+                {
+                    throw std::out_of_range("Number does not fit into the requested type");
+                }
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                // both limits are powers of two, so they are exact doubles
+                constexpr double lower = std::is_signed_v<T> ? static_cast<double>(std::numeric_limits<T>::min()) : 0.0;
+                constexpr double upper = std::is_signed_v<T> ? -lower
+                                                             : static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+                auto whole = std::trunc(number);
+                if (!(whole >= lower && whole < upper))
+                {
+                    throw std::out_of_range("Number does not fit into the requested type");
+                }
+            }
+            else if constexpr (std::is_floating_point_v<S> && sizeof(T) < sizeof(S))
+            {
+                if (std::isfinite(number) && std::abs(number) > static_cast<S>(std::numeric_limits<T>::max()))
+                {
+                    throw std::out_of_range("Number does not fit into the requested type");
+                }
+            }
+            return static_cast<T>(number);
+        }
+
+        /**
+         * If the TySonObject represents a AnnaDB Number, Bool or Timestamp Primitive
+         * you can convert it into the type you want, the value was already parsed while creating the object
+         *
+         * @tparam T must be a arithmetic type, bool is only true for a Bool with the value `true`
+         * @return the casted value
+         * @throw invalid_argument if it is no Number, Bool or Timestamp
+         * @throw out_of_range if the value does not fit into T
+         */
+        template<typename T>
+        requires std::is_arithmetic_v<T>
+        [[nodiscard]] T value() const
+        {
+            if (type_ == TySonType::Number || type_ == TySonType::Bool || type_ == TySonType::Timestamp)
+            {
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    return value<TySonType::Bool>();
+                }
+                else
+                {
+                    if (const auto *number = std::get_if<std::int64_t>(&data_))
+                    {
+                        return convert_number<T>(*number);
+                    }
+                    if (const auto *number = std::get_if<std::uint64_t>(&data_))
+                    {
+                        return convert_number<T>(*number);
+                    }
+                    if (const auto *number = std::get_if<double>(&data_))
+                    {
+                        return convert_number<T>(*number);
+                    }
+                    if (const auto *bl = std::get_if<bool>(&data_))
+                    {
+                        return static_cast<T>(*bl);
+                    }
+                }
+            }
+
+            throw std::invalid_argument("Invalid Type");
+        }
+    };
+
+
+    /**
+     * A position inside of a written query which is left open for a parameter
+     * @see Writer::param
+     */
+    struct ParamSlot
+    {
+        // where the value is inserted into the written text
+        std::size_t offset;
+        std::size_t index;
+        // the type the bound value must have, any type if empty
+        std::optional<TySonType> type;
+    };
+
+
+    /**
+     * Writes AnnaDB(TySON) into one growing buffer.
+     * Nested Vectors and Maps are appended in place so every value is copied once,
+     * numbers are formatted with std::to_chars.
+     *
+     * exampl.: writer.begin_map().key("num").number(5).separator().end_map() => m{s|num|:n|5|,}
+     */
+    class Writer
+    {
+        std::string buffer_ {};
+        std::vector<ParamSlot> params_ {};
+
+        /**
+         * Counts the chars instead of writing them, used to size a buffer exactly
+         */
+        struct Counter
+        {
+            std::size_t size = 0;
+
+            void append(std::string_view text) noexcept
+            {
+                size += text.size();
+            }
+
+            void append(char) noexcept
+            {
+                ++size;
+            }
+        };
+
+        struct Appender
+        {
+            std::string &out;
+
+            void append(std::string_view text)
+            {
+                out += text;
+            }
+
+            void append(char chr)
+            {
+                out += chr;
+            }
+        };
+
+        template<typename Out, typename T>
+        static void append_number(Out &out, T number)
+        {
+            char buffer[32];
+            auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            out.append(std::string_view {buffer, static_cast<std::size_t>(ptr - buffer)});
+        }
+
+        template<typename Out>
+        static void append_uuid(Out &out, const Uuid &uuid)
+        {
+            char buffer[36];
+            uuid.format(buffer);
+            out.append(std::string_view {buffer, sizeof(buffer)});
+        }
+
+        /**
+         * The text of a primitive as it is written inside of the `|`
+         */
+        template<typename Out>
+        static void append_scalar(Out &out, const TySonObject &obj)
+        {
+            std::visit([&out](const auto &value)
+                       {
+                           using T = std::decay_t<decltype(value)>;
+                           if constexpr (std::is_same_v<T, bool>)
+                           {
+                               out.append(value ? "true" : "false");
+                           }
+                           else if constexpr (std::is_arithmetic_v<T>)
+                           {
+                               append_number(out, value);
+                           }
+                           else if constexpr (std::is_same_v<T, TySonObject::string_type>)
+                           {
+                               out.append(std::string_view {value});
+                           }
+                       }, obj.data_);
+        }
+
+        template<typename Out>
+        static void append_value(Out &out, const TySonObject &obj)
+        {
+            switch (obj.type_)
+            {
+                case TySonType::Number:
+                    out.append("n|");
+                    append_scalar(out, obj);
+                    out.append('|');
+                    break;
+                case TySonType::String:
+                    out.append("s|");
+                    out.append(obj.str());
+                    out.append('|');
+                    break;
+                case TySonType::Bool:
+                    out.append("b|");
+                    append_scalar(out, obj);
+                    out.append('|');
+                    break;
+                case TySonType::Null:
+                    out.append("null");
+                    break;
+                case TySonType::Timestamp:
+                    out.append("utc|");
+                    append_scalar(out, obj);
+                    out.append('|');
+                    break;
+                case TySonType::Link:
+                    if (const auto *link = std::get_if<TySonObject::link_type>(&obj.data_))
+                    {
+                        out.append(std::string_view {*link->collection});
+                        out.append('|');
+                        append_uuid(out, link->id);
+                    }
+                    else
+                    {
+                        out.append(obj.str());
+                    }
+                    out.append('|');
+                    break;
+                case TySonType::Value:
+                    if (!obj.map().empty())
+                    {
+                        out.append("value|");
+                        out.append(obj.map().front().first.str());
+                        out.append("|:");
+                        append_value(out, obj.map().front().second);
+                    }
+                    break;
+                case TySonType::Vector:
+                    out.append("v[");
+                    for (const auto &element : obj.vec())
+                    {
+                        append_value(out, element);
+                        out.append(',');
+                    }
+                    out.append(']');
+                    break;
+                case TySonType::Map:
+                    out.append("m{");
+                    for (const auto &[key, value] : obj.map())
+                    {
+                        append_value(out, key);
+                        out.append(':');
+                        append_value(out, value);
+                        out.append(',');
+                    }
+                    out.append('}');
+                    break;
+                case TySonType::ProjectValue:
+                    if (!obj.map().empty())
+                    {
+                        out.append("value|");
+                        out.append(obj.map().front().first.str());
+                        out.append('|');
+                    }
+                    break;
+                case TySonType::Keep:
+                    out.append("keep");
+                    break;
+                default:
+                    break;
+            }
+        }
+
+    public:
+        Writer() = default;
+
+        /**
+         * Create a new Writer with a reserved buffer
+         *
+         * @param capacity exampl.: Writer::size(obj) to never grow while writing obj
+         */
+        explicit Writer(std::size_t capacity)
+        {
+            buffer_.reserve(capacity);
+        }
+
+        /**
+         * Append text as it is, it must already be valid TySON
+         */
+        Writer& raw(std::string_view text)
+        {
+            buffer_ += text;
+            return *this;
+        }
+
+        Writer& raw(char chr)
+        {
+            buffer_ += chr;
+            return *this;
+        }
+
+        /**
+         * Append a Number, exampl.: n|5|
+         */
+        template<typename T>
+        requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        Writer& number(T number)
+        {
+            Appender out {buffer_};
+            out.append("n|");
+            append_number(out, number);
+            out.append('|');
+            return *this;
+        }
+
+        /**
+         * Append a String, exampl.: s|foo|
+         */
+        Writer& string(std::string_view value)
+        {
+            buffer_ += "s|";
+            buffer_ += value;
+            buffer_ += '|';
+            return *this;
+        }
+
+        /**
+         * Append a Bool, exampl.: b|true|
+         */
+        Writer& boolean(bool value)
+        {
+            buffer_ += value ? "b|true|" : "b|false|";
+            return *this;
+        }
+
+        Writer& null()
+        {
+            buffer_ += "null";
+            return *this;
+        }
+
+        /**
+         * Append a Link, exampl.: users|e0bbcda2-0911-495e-9f0f-ce00db489f10|
+         */
+        Writer& link(std::string_view collection, std::string_view id)
+        {
+            buffer_ += collection;
+            buffer_ += '|';
+            buffer_ += id;
+            buffer_ += '|';
+            return *this;
+        }
+
+        Writer& link(std::string_view collection, const Uuid &id)
+        {
+            Appender out {buffer_};
+            out.append(collection);
+            out.append('|');
+            append_uuid(out, id);
+            out.append('|');
+            return *this;
+        }
+
+        /**
+         * Append the String key of a Map entry, exampl.: s|name|:
+         */
+        Writer& key(std::string_view name)
+        {
+            buffer_ += "s|";
+            buffer_ += name;
+            buffer_ += "|:";
+            return *this;
+        }
+
+        Writer& begin_vector()
+        {
+            buffer_ += "v[";
+            return *this;
+        }
+
+        Writer& end_vector()
+        {
+            buffer_ += ']';
+            return *this;
+        }
+
+        Writer& begin_map()
+        {
+            buffer_ += "m{";
+            return *this;
+        }
+
+        Writer& end_map()
+        {
+            buffer_ += '}';
+            return *this;
+        }
+
+        /**
+         * Append the `,` which follows every element of a Vector or Map
+         */
+        Writer& separator()
+        {
+            buffer_ += ',';
+            return *this;
+        }
+
+        /**
+         * Append a TySonObject with all its nested values
+         */
+        Writer& value(const TySonObject &obj)
+        {
+            Appender out {buffer_};
+            append_value(out, obj);
+            return *this;
+        }
+
+        /**
+         * The exact number of chars which Writer::value writes for a TySonObject
+         */
+        [[nodiscard]] static std::size_t size(const TySonObject &obj)
+        {
+            Counter counter {};
+            append_value(counter, obj);
+            return counter.size;
+        }
+
+        /**
+         * Write a TySonObject into a buffer sized exactly in a first pass
+         *
+         * @return the TySON string
+         */
+        [[nodiscard]] static std::string to_string(const TySonObject &obj)
+        {
+            Writer writer {size(obj)};
+            writer.value(obj);
+            return writer.take();
+        }
+
+        /**
+         * Leave a slot for a parameter of a prepared query, nothing is written
+         *
+         * @param index the position of the value when the query is bound
+         * @param type the type the bound value must have, any type if empty
+         */
+        Writer& param(std::size_t index, std::optional<TySonType> type = {})
+        {
+            params_.push_back({buffer_.size(), index, type});
+            return *this;
+        }
+
+        /**
+         *
+         * @return the slots left by param in the order they were written
+         */
+        [[nodiscard]] std::span<const ParamSlot> params() const noexcept
+        {
+            return params_;
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            buffer_.reserve(capacity);
+        }
+
+        void clear() noexcept
+        {
+            buffer_.clear();
+            params_.clear();
+        }
+
+        /**
+         * Drop everything which was written after the writer had the given size
+         *
+         * @param size the chars which are kept
+         * @param params the params which are kept
+         */
+        void truncate(std::size_t size, std::size_t params) noexcept
+        {
+            buffer_.resize(std::min(size, buffer_.size()));
+            params_.resize(std::min(params, params_.size()));
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return buffer_.size();
+        }
+
+        /**
+         *
+         * @return the written TySON, valid until the next write
+         */
+        [[nodiscard]] std::string_view view() const noexcept
+        {
+            return buffer_;
+        }
+
+        /**
+         * Move the written TySON out of the Writer, the Writer is empty afterwards
+         */
+        [[nodiscard]] std::string take() noexcept
+        {
+            params_.clear();
+            return std::exchange(buffer_, {});
+        }
+    };
+
+    // written through one Writer instead of a stream per nested Vector and Map
+    inline std::ostream& operator<<(std::ostream &out, TySonObject const &obj) noexcept
+    {
+        Writer writer {};
+        writer.value(obj);
+        return out << writer.view();
+    }
+
+    /**
+     * A single AnnaDB(TySON) value found by the TySonParser without building a TySonObject
+     *
+     * exampl.: for `users|e0bbcda2-0911-495e-9f0f-ce00db489f10|`
+     *      type  => TySonType::Link
+     *      tag   => `users`
+     *      value => `e0bbcda2-0911-495e-9f0f-ce00db489f10`
+     *
+     * for Vectors and Maps the value is the body between the brackets
+     */
+    struct TySonToken
+    {
+        TySonType type = TySonType::Null;
+        std::string_view raw {};
+        std::string_view tag {};
+        std::string_view value {};
+    };
+
+    /**
+     * Receiver of the events emitted by TySonParser::walk.
+     * Every callback is optional, events without a matching callback are skipped.
+     *
+     *      begin_vector()                   end_vector()
+     *      begin_map()                      end_map()
+     *      on_key(const TySonToken &key)    for every key of a Map, links keep their collection in the tag
+     *      on_link(std::string_view collection, std::string_view id)
+     *      on_number(std::string_view value)
+     *      on_string(std::string_view value)
+     *      on_bool(bool value)
+     *      on_timestamp(std::string_view value)
+     *      on_null()
+     *      on_keep()
+     *      on_object(std::string_view value)
+     *
+     * All string_views point into the walked input.
+     * A handler needs at least one of the callbacks and every declared callback must take the parameters above,
+     * otherwise it would never be called.
+     */
+    namespace handling
+    {
+        template<typename T>
+        concept any_callback = requires(T &handler) { handler.begin_vector(); }
+          || requires(T &handler) { handler.end_vector(); }
+          || requires(T &handler) { handler.begin_map(); }
+          || requires(T &handler) { handler.end_map(); }
+          || requires(T &handler, const TySonToken &key) { handler.on_key(key); }
+          || requires(T &handler, std::string_view value) { handler.on_link(value, value); }
+          || requires(T &handler, std::string_view value) { handler.on_number(value); }
+          || requires(T &handler, std::string_view value) { handler.on_string(value); }
+          || requires(T &handler) { handler.on_bool(true); }
+          || requires(T &handler, std::string_view value) { handler.on_timestamp(value); }
+          || requires(T &handler) { handler.on_null(); }
+          || requires(T &handler) { handler.on_keep(); }
+          || requires(T &handler, std::string_view value) { handler.on_object(value); };
+
+        // a callback which is declared with other parameters is an error instead of being skipped
+        template<typename T>
+        concept valid_callbacks =
+                (!requires { &T::begin_vector; } || requires(T &handler) { handler.begin_vector(); }) &&
+                (!requires { &T::end_vector; } || requires(T &handler) { handler.end_vector(); }) &&
+                (!requires { &T::begin_map; } || requires(T &handler) { handler.begin_map(); }) &&
+                (!requires { &T::end_map; } || requires(T &handler) { handler.end_map(); }) &&
+                (!requires { &T::on_key; } || requires(T &handler, const TySonToken &key) { handler.on_key(key); }) &&
+                (!requires { &T::on_link; } ||
+                 requires(T &handler, std::string_view value) { handler.on_link(value, value); }) &&
+                (!requires { &T::on_number; } ||
+                 requires(T &handler, std::string_view value) { handler.on_number(value); }) &&
+                (!requires { &T::on_string; } ||
+                 requires(T &handler, std::string_view value) { handler.on_string(value); }) &&
+                (!requires { &T::on_bool; } || requires(T &handler) { handler.on_bool(true); }) &&
+                (!requires { &T::on_timestamp; } ||
+                 requires(T &handler, std::string_view value) { handler.on_timestamp(value); }) &&
+                (!requires { &T::on_null; } || requires(T &handler) { handler.on_null(); }) &&
+                (!requires { &T::on_keep; } || requires(T &handler) { handler.on_keep(); }) &&
+                (!requires { &T::on_object; } ||
+                 requires(T &handler, std::string_view value) { handler.on_object(value); });
+    }
+
+    template<typename T>
+    concept TySonHandler = std::is_class_v<T> && handling::any_callback<T> && handling::valid_callbacks<T>;
+
+    /**
+     * Single pass recursive-descent parser for AnnaDB(TySON) strings.
+     * Every byte is visited once, nested Vectors and Maps are built in place
+     * and no intermediate strings are created to find the structure.
+     * Primitive values are delimited by `|` so they may contain `,` and `:`.
+     *
+     * exampl.: m{s|name|:s|foo, bar: baz|,s|nums|:v[n|1|,n|2|,],}
+     */
+    class TySonParser
+    {
+        std::string_view input_;
+        std::size_t pos_ = 0;
+
+        // the links of everything parsed by this parser share their collection names
+        CollectionNames own_names_ {};
+        CollectionNames *names_ = nullptr;
+
+        // optional structural index of input_ or of a string containing input_
+        const StructuralIndex *index_ = nullptr;
+        std::size_t offset_ = 0;
+        std::size_t cursor_ = 0;
+
+        /**
+         * Move the cursor to the first structural position at or behind the current position
+         *
+         * @return the structural position relative to input_ or input_.size() if there is none
+         */
+        std::size_t next_structural() noexcept
+        {
+            const auto &positions = index_->positions();
+            while (cursor_ < positions.size() && positions[cursor_] < offset_ + pos_)
+            {
+                ++cursor_;
+            }
+            if (cursor_ == positions.size())
+            {
+                return input_.size();
+            }
+            return std::min(positions[cursor_] - offset_, input_.size());
+        }
+
+        [[nodiscard]] bool at_end() const noexcept
+        {
+            return pos_ >= input_.size();
+        }
+
+        void skip_whitespace() noexcept
+        {
+            while (!at_end() && std::isspace(static_cast<unsigned char>(input_[pos_])))
+            {
+                ++pos_;
+            }
+        }
+
+        /**
+         * Read the type tag in front of a value
+         * exampl.: `s` for s|foo|, `users` for users|<uuid>| or `null`
+         *
+         * @return the tag without the following separator
+         */
+        std::string_view read_tag() noexcept
+        {
+            auto start = pos_;
+            while (!at_end())
+            {
+                auto chr = input_[pos_];
+                if (chr == '|' || chr == ',' || chr == ':' || chr == '[' || chr == ']' || chr == '{' || chr == '}' ||
+                    std::isspace(static_cast<unsigned char>(chr)))
+                {
+                    break;
+                }
+                ++pos_;
+            }
+            return input_.substr(start, pos_ - start);
+        }
+
+        /**
+         * Read everything until the closing `|`, the opening one is already consumed
+         *
+         * @return the raw value
+         */
+        std::string_view read_value() noexcept
+        {
+            // inside of a value only the closing `|` is structural
+            auto end = index_ ? next_structural() : input_.find('|', pos_);
+            if (end == std::string_view::npos)
+            {
+                end = input_.size();
+            }
+
+            auto value = input_.substr(pos_, end - pos_);
+            pos_ = std::min(end + 1, input_.size());
+            return value;
+        }
+
+        /**
+         * Read the tag and the primitive value of the next token.
+         * For Vectors and Maps only the opening bracket is consumed.
+         *
+         * @return the token, for Vectors and Maps without value
+         */
+        TySonToken read_head() noexcept
+        {
+            skip_whitespace();
+
+            TySonToken token;
+            auto start = pos_;
+            token.tag = read_tag();
+
+            if (at_end() || input_[pos_] != '|')
+            {
+                if (token.tag == "v" && !at_end() && input_[pos_] == '[')
+                {
+                    ++pos_;
+                    token.type = TySonType::Vector;
+                }
+                else if (token.tag == "m" && !at_end() && input_[pos_] == '{')
+                {
+                    ++pos_;
+                    token.type = TySonType::Map;
+                }
+                else if (token.tag == "null")
+                {
+                    token.type = TySonType::Null;
+                }
+                else if (token.tag == "keep")
+                {
+                    token.type = TySonType::Keep;
+                    token.value = token.tag;
+                }
+                else
+                {
+                    token.type = TySonType::Object;
+                    token.value = token.tag;
+                }
+            }
+            else
+            {
+                ++pos_;
+                token.value = read_value();
+
+                if (token.tag == "uts")
+                {
+                    token.type = TySonType::Timestamp;
+                }
+                else if (token.tag.size() > 1)
+                {
+                    token.type = TySonType::Link;
+                }
+                else
+                {
+                    token.type = token.tag.empty() ? TySonType::Object : TySonObject::cast_type_string(token.tag[0]);
+                }
+            }
+
+            token.raw = input_.substr(start, pos_ - start);
+            return token;
+        }
+
+        /**
+         * Skip the body of a Vector or Map, the opening bracket is already consumed
+         *
+         * @return true if the closing bracket was found
+         */
+        bool skip_container() noexcept
+        {
+            std::size_t depth = 1;
+            if (index_)
+            {
+                // jump over the indexed positions, brackets inside of values are not indexed
+                for (auto next = next_structural(); next < input_.size(); next = next_structural())
+                {
+                    pos_ = next + 1;
+                    switch (input_[next])
+                    {
+                        case '[':
+                        case '{':
+                            ++depth;
+                            break;
+                        case ']':
+                        case '}':
+                            if (--depth == 0)
+                            {
+                                return true;
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                pos_ = input_.size();
+                return false;
+            }
+
+            while (!at_end() && depth > 0)
+            {
+                switch (input_[pos_++])
+                {
+                    case '|':
+                        read_value();
+                        break;
+                    case '[':
+                    case '{':
+                        ++depth;
+                        break;
+                    case ']':
+                    case '}':
+                        --depth;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return depth == 0;
+        }
+
+        /**
+         * AnnaDB(TySON) Vector example:
+         * v[n|1|,n|2|,n|3|,]
+         */
+        void parse_vector(TySonObject &object) noexcept
+        {
+            object.type_ = TySonType::Vector;
+            auto &vector = object.data_.emplace<TySonObject::vector_type>(object.alloc_);
+            while (!container_closed(']'))
+            {
+                auto start = pos_;
+                vector.emplace_back();
+                parse_value(vector.back());
+
+                if (pos_ == start)
+                {
+                    // unknown structural char, skip it instead of looping forever
+                    ++pos_;
+                }
+            }
+        }
+
+        /**
+         * AnnaDB(TySON) Map example:
+         * m{ s|bar|: s|baz|,}
+         */
+        void parse_map(TySonObject &object) noexcept
+        {
+            object.type_ = TySonType::Map;
+            auto &map = object.data_.emplace<TySonObject::map_type>(object.alloc_);
+            while (!container_closed('}'))
+            {
+                auto start = pos_;
+                TySonObject key {object.alloc_};
+                parse_value(key);
+
+                if (consume(':'))
+                {
+                    TySonObject value {object.alloc_};
+                    parse_value(value);
+                    map.emplace_back(std::move(key), std::move(value));
+                }
+                else if (pos_ == start)
+                {
+                    ++pos_;
+                }
+            }
+            TySonObject::sort_entries(map);
+        }
+
+        /**
+         * Fill a TySonObject from the primitive parts of a token
+         */
+        void assign(TySonObject &object, const TySonToken &token) noexcept
+        {
+            object.type_ = token.type;
+            if (token.type == TySonType::Link)
+            {
+                object.set_link(token.tag, token.value, names_ ? names_ : &own_names_);
+            }
+            else if (token.type == TySonType::Null)
+            {
+                object.data_ = std::monostate {};
+            }
+            else if (token.type == TySonType::Number || token.type == TySonType::Timestamp)
+            {
+                object.set_number(token.value);
+            }
+            else if (token.type == TySonType::Bool)
+            {
+                object.data_.emplace<bool>(token.value == "true");
+            }
+            else
+            {
+                object.set_str(token.value);
+            }
+        }
+
+        void parse_value(TySonObject &object) noexcept
+        {
+            auto token = read_head();
+            switch (token.type)
+            {
+                case TySonType::Vector:
+                    parse_vector(object);
+                    break;
+                case TySonType::Map:
+                    parse_map(object);
+                    break;
+                default:
+                    assign(object, token);
+            }
+        }
+
+        template<TySonHandler Handler>
+        static void emit(Handler &handler, const TySonToken &token)
+        {
+            switch (token.type)
+            {
+                case TySonType::Link:
+                    if constexpr (requires { handler.on_link(token.tag, token.value); })
+                    {
+                        handler.on_link(token.tag, token.value);
+                    }
+                    break;
+                case TySonType::Number:
+                    if constexpr (requires { handler.on_number(token.value); })
+                    {
+                        handler.on_number(token.value);
+                    }
+                    break;
+                case TySonType::String:
+                    if constexpr (requires { handler.on_string(token.value); })
+                    {
+                        handler.on_string(token.value);
+                    }
+                    break;
+                case TySonType::Bool:
+                    if constexpr (requires { handler.on_bool(true); })
+                    {
+                        handler.on_bool(token.value == "true");
+                    }
+                    break;
+                case TySonType::Timestamp:
+                    if constexpr (requires { handler.on_timestamp(token.value); })
+                    {
+                        handler.on_timestamp(token.value);
+                    }
+                    break;
+                case TySonType::Null:
+                    if constexpr (requires { handler.on_null(); })
+                    {
+                        handler.on_null();
+                    }
+                    break;
+                case TySonType::Keep:
+                    if constexpr (requires { handler.on_keep(); })
+                    {
+                        handler.on_keep();
+                    }
+                    break;
+                default:
+                    if constexpr (requires { handler.on_object(token.value); })
+                    {
+                        handler.on_object(token.value);
+                    }
+                    break;
+            }
+        }
+
+        template<TySonHandler Handler>
+        void walk_vector(Handler &handler)
+        {
+            if constexpr (requires { handler.begin_vector(); })
+            {
+                handler.begin_vector();
+            }
+
+            while (!container_closed(']'))
+            {
+                auto start = pos_;
+                walk_value(handler);
+
+                if (pos_ == start)
+                {
+                    ++pos_;
+                }
+            }
+
+            if constexpr (requires { handler.end_vector(); })
+            {
+                handler.end_vector();
+            }
+        }
+
+        template<TySonHandler Handler>
+        void walk_map(Handler &handler)
+        {
+            if constexpr (requires { handler.begin_map(); })
+            {
+                handler.begin_map();
+            }
+
+            while (!container_closed('}'))
+            {
+                auto start = pos_;
+                auto key = next();
+
+                if (consume(':'))
+                {
+                    if constexpr (requires { handler.on_key(key); })
+                    {
+                        handler.on_key(key);
+                    }
+                    walk_value(handler);
+                }
+                else if (pos_ == start)
+                {
+                    ++pos_;
+                }
+            }
+
+            if constexpr (requires { handler.end_map(); })
+            {
+                handler.end_map();
+            }
+        }
+
+        template<TySonHandler Handler>
+        void walk_value(Handler &handler)
+        {
+            auto token = read_head();
+            switch (token.type)
+            {
+                case TySonType::Vector:
+                    walk_vector(handler);
+                    break;
+                case TySonType::Map:
+                    walk_map(handler);
+                    break;
+                default:
+                    emit(handler, token);
+            }
+        }
+
+    public:
+
+        /**
+         * Create a new parser over a raw AnnaDB(TySON) string
+         *
+         * @param input must outlive the parser
+         */
+        explicit TySonParser(std::string_view input) noexcept : input_(input) {}
+
+        /**
+         * Create a new parser which jumps between the positions of a structural index
+         *
+         * @param input must outlive the parser and be a part of the indexed string
+         * @param index must outlive the parser
+         */
+        TySonParser(std::string_view input, const StructuralIndex &index) noexcept : input_(input), index_(&index)
+        {
+            offset_ = static_cast<std::size_t>(input.data() - index.input().data());
+            const auto &positions = index.positions();
+            cursor_ = static_cast<std::size_t>(
+                    std::lower_bound(positions.begin(), positions.end(), offset_) - positions.begin());
         }
 
         /**
-         * Get the current value of the TySonObject
+         * Parse the next value of the input
          *
-         * @tparam T must be of type TySonType
-         * @return the current value representation
+         * @param alloc used for the parsed value and all nested values
+         * @return the parsed TySonObject
          */
-        template<TySonType T>
-        [[nodiscard]] std::string value() const noexcept
+        [[nodiscard]] TySonObject parse(const TySonObject::allocator_type &alloc = {}) noexcept
         {
-            return value_;
+            TySonObject object {alloc};
+            parse_value(object);
+            return object;
         }
 
         /**
-         * If the TySonObject represents a AnnaDB Bool Primitive
+         * Build a TySonObject from a token found by TySonParser::next
          *
-         * @tparam T TySonType::Bool
-         * @return true if the value representation is the string `true` false otherwise
+         * @param token must point into a still living input
+         * @param alloc used for the parsed value and all nested values
+         * @param names shares the collection names of links with everything else parsed into it
+         * @return the parsed TySonObject
          */
-        template<TySonType T>
-        requires (T == TySonType::Bool)
-        [[nodiscard]] bool value() const noexcept
+        [[nodiscard]] static TySonObject parse(const TySonToken &token,
+                                               const TySonObject::allocator_type &alloc = {},
+                                               CollectionNames *names = nullptr) noexcept
         {
-            return value_ == "true";
+            TySonObject object {alloc};
+            TySonParser body {token.value};
+            body.names_ = names;
+            if (token.type == TySonType::Vector || token.type == TySonType::Map)
+            {
+                token.type == TySonType::Vector ? body.parse_vector(object) : body.parse_map(object);
+            }
+            else
+            {
+                body.assign(object, token);
+            }
+            return object;
         }
 
         /**
-         * If the TySonObject represents a AnnaDB null Primitive
+         * Walk the next value and report it to the handler instead of building a TySonObject,
+         * nothing is allocated so the memory usage does not depend on the size of the input
          *
-         * @tparam T TySonType::Null
-         * @return an empty string to indicate null
+         * @param handler @see TySonHandler
          */
-        template<TySonType T>
-        requires (T == TySonType::Null)
-        [[nodiscard]] std::string value() const noexcept
+        template<typename Handler>
+        requires std::is_class_v<Handler>
+        void walk(Handler &handler)
         {
-            return "";
+            static_assert(handling::any_callback<Handler>,
+                          "the handler has none of the callbacks of TySonHandler, check their names and parameters");
+            static_assert(handling::valid_callbacks<Handler>,
+                          "a callback of the handler does not take the parameters documented at TySonHandler");
+            walk_value(handler);
         }
 
         /**
-         * If the TySonObject represents a AnnaDB Link Primitive
+         * Walk a value found by TySonParser::next
          *
-         * @tparam T TySonType::Link
-         * @return collection name and object_id as uuid-string
+         * @param token must point into a still living input
+         * @param handler @see TySonHandler
          */
-        template<TySonType T>
-        requires (T == TySonType::Link)
-        [[nodiscard]] std::pair<std::string, std::string> value() const noexcept
+        template<typename Handler>
+        requires std::is_class_v<Handler>
+        static void walk(const TySonToken &token, Handler &handler)
         {
-            return link_;
+            static_assert(handling::any_callback<Handler>,
+                          "the handler has none of the callbacks of TySonHandler, check their names and parameters");
+            static_assert(handling::valid_callbacks<Handler>,
+                          "a callback of the handler does not take the parameters documented at TySonHandler");
+
+            TySonParser body {token.value};
+            switch (token.type)
+            {
+                case TySonType::Vector:
+                    body.walk_vector(handler);
+                    break;
+                case TySonType::Map:
+                    body.walk_map(handler);
+                    break;
+                default:
+                    emit(handler, token);
+            }
         }
 
         /**
-         * If the TySonObject represents a AnnaDB Vector
+         * Find the next value without building it, nested values are skipped
          *
-         * @tparam T TySonType::Vector
-         * @return vector of TySonObjects
+         * @return the token of the next value
          */
-        template<TySonType T>
-        requires (T == TySonType::Vector)
-        [[nodiscard]] std::vector<TySonObject> value() const noexcept
+        [[nodiscard]] TySonToken next() noexcept
         {
-            return vector_;
+            auto token = read_head();
+            if (token.type == TySonType::Vector || token.type == TySonType::Map)
+            {
+                auto body_start = pos_;
+                auto closed = skip_container();
+
+                auto raw_start = static_cast<std::size_t>(token.raw.data() - input_.data());
+                auto body_end = closed ? pos_ - 1 : pos_;
+                token.value = input_.substr(body_start, body_end - body_start);
+                token.raw = input_.substr(raw_start, pos_ - raw_start);
+            }
+            return token;
         }
 
         /**
-         * If the TySonObject represents a AnnaDB Map
+         * Consume the char if it is the next one after optional whitespace
          *
-         * @tparam T TySonType::Map
-         * @return Key-Value pairs of TySonObjects
+         * @param chr the expected char
+         * @return true if consumed
          */
-        template<TySonType T>
-        requires (T == TySonType::Map)
-        [[nodiscard]] std::map<TySonObject, TySonObject> value() const noexcept
+        bool consume(char chr) noexcept
         {
-            return map_;
+            skip_whitespace();
+            if (!at_end() && input_[pos_] == chr)
+            {
+                ++pos_;
+                return true;
+            }
+            return false;
         }
 
         /**
-         * If the TySonObject represents a AnnaDB Number Primitive
-         * you can parse it into the type you want normal it will be returned as string
+         * Skip the separator between two elements and detect the end of the container
          *
-         * @tparam T must be a arithmetic type
-         * @return the casted value
+         * @param closing `]` for Vectors and `}` for Maps
+         * @return true if the container is closed or the input ends
          */
-        template<typename T>
-        requires std::is_arithmetic_v<T>
-        [[nodiscard]] T value() const
+        bool container_closed(char closing) noexcept
         {
-            if (type_ == TySonType::Number || type_ == TySonType::Bool || type_ == TySonType::Timestamp)
+            while (true)
             {
-                std::size_t pos{};
-
-                switch (*typeid(T).name())
+                skip_whitespace();
+                if (at_end())
+                {
+                    return true;
+                }
+                if (input_[pos_] == closing)
+                {
+                    ++pos_;
+                    return true;
+                }
+                if (input_[pos_] != ',')
                 {
-                    case 's':
-                    case 'j':
-                    case 'i':
-                        return std::stoi(value_, &pos);
-                    case 'l':
-                        return std::stol(value_, &pos);
-                    case 'f':
-                        return static_cast<T>(std::stof(value_, &pos));
-                    case 'd':
-                        return static_cast<T>(std::stod(value_, &pos));
-                    case 'x':
-                        return std::stoll(value_, &pos);
-                    case 'e':
-                        return static_cast<T>(std::stold(value_, &pos));
-                    case 'b':
-                        return value_ == "true";
-                    case 'c':
-                        return value_.c_str()[0];
+                    return false;
                 }
+                ++pos_;
             }
+        }
 
-            throw std::invalid_argument("Invalid Type");
+        /**
+         *
+         * @return the amount of consumed chars
+         */
+        [[nodiscard]] std::size_t position() const noexcept
+        {
+            return pos_;
         }
     };
 
+    inline TySonObject::TySonObject(std::string_view object, const allocator_type &alloc) noexcept : alloc_(alloc)
+    {
+        // building the index only pays off if there is enough to jump over,
+        // its 32 bit offsets can not hold the positions of larger inputs
+        if (object.size() < 4096 || object.size() > StructuralIndex::max_size)
+        {
+            *this = TySonParser(object).parse(alloc);
+        }
+        else
+        {
+            StructuralIndex index {object};
+            *this = TySonParser(object, index).parse(alloc);
+        }
+    }
+
 
     class TySonCollectionObject
     {
-        std::vector<TySonObject> collection_ids_{};
-        std::vector<std::pair<TySonObject, TySonObject>> collection_objects_{};
+    public:
+        using allocator_type = TySonObject::allocator_type;
+
+    private:
+        /**
+         * Lookup tables from the links of the entries to their positions,
+         * the collection names point into the links stored inside of the collection.
+         * Links with an id which is no uuid are not part of ids and links, they are searched one by one.
+         */
+        struct LinkHash
+        {
+            std::size_t operator()(const std::pair<std::string_view, Uuid> &link) const noexcept
+            {
+                auto hash = std::hash<Uuid> {}(link.second);
+                return hash ^ (std::hash<std::string_view> {}(link.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+            }
+        };
+
+        struct Index
+        {
+            // true if collection_objects_ is indexed, false for collection_ids_
+            bool objects = false;
+            // uuid => position
+            std::unordered_map<Uuid, std::size_t> ids {};
+            // (collection, uuid) => position
+            std::unordered_map<std::pair<std::string_view, Uuid>, std::size_t, LinkHash> links {};
+            // collection => positions of its entries in the order they were added
+            std::unordered_map<std::string_view, std::vector<std::size_t>> collections {};
+        };
+
+        // the entries stay in the order they were added
+        std::pmr::vector<TySonObject> collection_ids_{};
+        std::pmr::vector<std::pair<TySonObject, TySonObject>> collection_objects_{};
+        Lazy<Index> index_ {};
+        // the collection names of all added links
+        CollectionNames names_ {};
+
+        static const TySonObject& link_of(const TySonObject &id) noexcept
+        {
+            return id;
+        }
+
+        static const TySonObject& link_of(const std::pair<TySonObject, TySonObject> &object) noexcept
+        {
+            return object.first;
+        }
+
+        /**
+         * Build the index of the stored entries, it is built once on the first lookup
+         * and stays valid until the next entry is added. The entries themselves are not changed.
+         *
+         * @return the index of collection_objects_ or collection_ids_ if there are no objects
+         */
+        const Index& index() const
+        {
+            return index_.get([this]
+                              {
+                                  Index index {};
+                                  const auto build = [&index](const auto &entries)
+                                  {
+                                      index.ids.reserve(entries.size());
+                                      index.links.reserve(entries.size());
+
+                                      for (std::size_t pos = 0; pos < entries.size(); ++pos)
+                                      {
+                                          const auto &link = link_of(entries[pos]);
+                                          auto collection = link.link_collection();
+
+                                          if (auto uuid = link.link_uuid())
+                                          {
+                                              index.ids.try_emplace(*uuid, pos);
+                                              index.links.try_emplace(std::make_pair(collection, *uuid), pos);
+                                          }
+                                          index.collections[collection].push_back(pos);
+                                      }
+                                  };
+
+                                  index.objects = !collection_objects_.empty();
+                                  index.objects ? build(collection_objects_) : build(collection_ids_);
+                                  return index;
+                              });
+        }
+
+        /**
+         * @return the position of the entry or npos if not found
+         */
+        std::size_t find(std::string_view obj_id) const
+        {
+            auto uuid = Uuid::parse(obj_id);
+            if (!uuid)
+            {
+                return find_other({}, obj_id);
+            }
+
+            auto found = index().ids.find(*uuid);
+            return found != index().ids.end() ? found->second : std::string_view::npos;
+        }
+
+        std::size_t find(std::string_view collection, std::string_view obj_id) const
+        {
+            auto uuid = Uuid::parse(obj_id);
+            if (!uuid)
+            {
+                return find_other(collection, obj_id);
+            }
+
+            auto found = index().links.find({collection, *uuid});
+            return found != index().links.end() ? found->second : std::string_view::npos;
+        }
+
+        /**
+         * Search an entry whose id is no uuid, AnnaDB itself only creates uuids
+         *
+         * @param collection the collection name, empty to search all collections
+         * @return the position of the entry or npos if not found
+         */
+        std::size_t find_other(std::string_view collection, std::string_view obj_id) const
+        {
+            const auto search = [&](const auto &entries) -> std::size_t
+            {
+                for (std::size_t pos = 0; pos < entries.size(); ++pos)
+                {
+                    const auto &link = link_of(entries[pos]);
+                    if (!link.link_uuid() && (collection.empty() || link.link_collection() == collection) &&
+                        link.template value<TySonType::Link>().second == obj_id)
+                    {
+                        return pos;
+                    }
+                }
+                return std::string_view::npos;
+            };
+            return collection_objects_.empty() ? search(collection_ids_) : search(collection_objects_);
+        }
+
+    public:
+        /**
+         * The entries of one collection in the order they were added, valid until the next add
+         *
+         * @tparam Entry a link TySonObject or a pair of link and value
+         */
+        template<typename Entry>
+        class Entries : public std::ranges::view_interface<Entries<Entry>>
+        {
+            const Entry *entries_ = nullptr;
+            std::span<const std::size_t> positions_ {};
+
+        public:
+            class Iterator
+            {
+                const Entry *entries_ = nullptr;
+                const std::size_t *position_ = nullptr;
+
+            public:
+                using value_type = Entry;
+                using difference_type = std::ptrdiff_t;
+
+                Iterator() = default;
+                Iterator(const Entry *entries, const std::size_t *position) noexcept
+                    : entries_(entries), position_(position)
+                {}
+
+                const Entry& operator*() const noexcept
+                {
+                    return entries_[*position_];
+                }
+
+                const Entry* operator->() const noexcept
+                {
+                    return &entries_[*position_];
+                }
+
+                Iterator& operator++() noexcept
+                {
+                    ++position_;
+                    return *this;
+                }
+
+                Iterator operator++(int) noexcept
+                {
+                    auto current = *this;
+                    ++position_;
+                    return current;
+                }
+
+                bool operator==(const Iterator &other) const noexcept
+                {
+                    return position_ == other.position_;
+                }
+            };
+
+            Entries() = default;
+            Entries(const Entry *entries, std::span<const std::size_t> positions) noexcept
+                : entries_(entries), positions_(positions)
+            {}
+
+            [[nodiscard]] Iterator begin() const noexcept
+            {
+                return {entries_, positions_.data()};
+            }
+
+            [[nodiscard]] Iterator end() const noexcept
+            {
+                return {entries_, positions_.data() + positions_.size()};
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return positions_.size();
+            }
+
+            const Entry& operator[](std::size_t pos) const noexcept
+            {
+                return entries_[positions_[pos]];
+            }
+        };
+
+    private:
+        template<typename Entry>
+        Entries<Entry> range(const std::pmr::vector<Entry> &entries, std::string_view collection) const
+        {
+            const auto &found = index().collections;
+            auto positions = found.find(collection);
+            if (positions == found.end())
+            {
+                return {};
+            }
+            return {entries.data(), positions->second};
+        }
+
+        /**
+         *
+         * @return true if the index was built from the objects, false if it was built from the ids
+         */
+        [[nodiscard]] bool indexes_objects() const
+        {
+            return index().objects;
+        }
 
     public:
         TySonCollectionObject() = default;
-        explicit TySonCollectionObject(size_t size, bool objects = false)
+
+        /**
+         * @param size the expected amount of IDs or Objects
+         * @param objects true if it holds Objects, false for IDs
+         * @param alloc used for the collection and all of its TySonObjects
+         */
+        explicit TySonCollectionObject(size_t size, bool objects = false, const allocator_type &alloc = {})
+            : collection_ids_(alloc), collection_objects_(alloc)
         {
             if (objects)
             {
@@ -716,6 +2588,43 @@ namespace tyson
                 collection_ids_.reserve(size);
             }
         }
+
+        // the index points into the entries of other, so it is never copied or moved
+        TySonCollectionObject(const TySonCollectionObject &other) : collection_ids_(other.collection_ids_),
+                                                                   collection_objects_(other.collection_objects_),
+                                                                   names_(other.names_)
+        {}
+
+        TySonCollectionObject(TySonCollectionObject &&other) noexcept
+            : collection_ids_(std::move(other.collection_ids_)),
+              collection_objects_(std::move(other.collection_objects_)),
+              names_(std::move(other.names_))
+        {
+            other.index_.reset();
+        }
+
+        TySonCollectionObject& operator=(const TySonCollectionObject &other)
+        {
+            if (this != &other)
+            {
+                collection_ids_ = other.collection_ids_;
+                collection_objects_ = other.collection_objects_;
+                names_ = other.names_;
+                index_.reset();
+            }
+            return *this;
+        }
+
+        TySonCollectionObject& operator=(TySonCollectionObject &&other)
+        {
+            collection_ids_ = std::move(other.collection_ids_);
+            collection_objects_ = std::move(other.collection_objects_);
+            names_ = std::move(other.names_);
+            index_.reset();
+            other.index_.reset();
+            return *this;
+        }
+
         ~TySonCollectionObject() = default;
 
         /**
@@ -728,6 +2637,7 @@ namespace tyson
         {
             auto tyson_str_data = utils::split(object, '|');
             collection_ids_.emplace_back(TySonObject::Link(tyson_str_data[0], tyson_str_data[1]));
+            index_.reset();
         };
 
         /**
@@ -740,8 +2650,45 @@ namespace tyson
         {
             const auto new_val = std::make_pair(TySonObject(link), TySonObject(value));
             collection_objects_.emplace_back(new_val);
+            index_.reset();
+        };
+
+        /**
+         * Add an already scanned AnnaDB(TySon) link to the current collection,
+         * its uuid is stored as 16 bytes and its collection name is shared with the other links
+         *
+         * @param link the token of the link
+         */
+        void add(const TySonToken &link)
+        {
+            collection_ids_.emplace_back(TySonParser::parse(link, get_allocator(), &names_));
+            index_.reset();
+        }
+
+        /**
+         * Add a new pair of already scanned AnnaDB(TySon) values to the current collection.
+         * The tokens are built into TySonObjects without searching for their end again
+         *
+         * @param link the token of the link
+         * @param value the token of the value
+         */
+        void add(const TySonToken &link, const TySonToken &value)
+        {
+            auto alloc = get_allocator();
+            collection_objects_.emplace_back(TySonParser::parse(link, alloc, &names_),
+                                             TySonParser::parse(value, alloc, &names_));
+            index_.reset();
         };
 
+        /**
+         *
+         * @return the allocator of this collection
+         */
+        [[nodiscard]] allocator_type get_allocator() const noexcept
+        {
+            return collection_objects_.get_allocator();
+        }
+
         /**
          * Get the node value from the AnnaDB response data|:objects
          * Example:
@@ -754,16 +2701,18 @@ namespace tyson
          */
         template<TySonType T>
         requires (T == TySonType::Object)
-        [[ nodiscard ]] std::optional<std::pair<TySonObject, TySonObject>> get(std::string_view obj_id) noexcept
+        [[ nodiscard ]] std::optional<std::pair<TySonObject, TySonObject>> get(std::string_view obj_id) const
         {
-            for (const auto &val: collection_objects_)
+            if (!indexes_objects())
             {
-                if (val.first.value<TySonType::Link>().second == obj_id)
-                {
-                    return val;
-                }
+                return {};
             }
-            return {};
+            auto pos = find(obj_id);
+            if (pos == std::string_view::npos)
+            {
+                return {};
+            }
+            return collection_objects_[pos];
         }
 
         /**
@@ -771,22 +2720,17 @@ namespace tyson
          *
          * @tparam T TySonType::Objects
          * @param collection name
-         * @return vector of TySonObject pairs which belongs to the collection
+         * @return TySonObject pairs which belongs to the collection in the order they were added, valid until the next add
          */
         template<TySonType T>
         requires (T == TySonType::Objects)
-        [[ nodiscard ]] std::vector<std::pair<TySonObject, TySonObject>> get(std::string_view collection) noexcept
+        [[ nodiscard ]] Entries<std::pair<TySonObject, TySonObject>> get(std::string_view collection) const
         {
-            std::vector<std::pair<TySonObject, TySonObject>> result{};
-            std::for_each(collection_objects_.begin(), collection_objects_.end(),
-                          [&collection, &result](const std::pair<TySonObject, TySonObject> &val)
-                          {
-                              if (val.first.value<TySonType::Link>().first == collection)
-                              {
-                                  result.emplace_back(val);
-                              }
-                          });
-            return result;
+            if (!indexes_objects())
+            {
+                return {};
+            }
+            return range(collection_objects_, collection);
         }
 
         /**
@@ -799,18 +2743,18 @@ namespace tyson
          */
         template<TySonType T>
         requires (T == TySonType::Object)
-        [[ nodiscard ]] std::optional<std::pair<TySonObject, TySonObject>> get(std::string_view collection, std::string_view obj_id) noexcept
+        [[ nodiscard ]] std::optional<std::pair<TySonObject, TySonObject>> get(std::string_view collection, std::string_view obj_id) const
         {
-            for (const std::pair<TySonObject, TySonObject> &val: collection_objects_)
+            if (!indexes_objects())
             {
-                auto tysonLink = val.first.value<TySonType::Link>();
-                if (std::tie(tysonLink.first, tysonLink.second) == std::tie(collection, obj_id))
-                {
-                    return val;
-                }
+                return {};
             }
-
-            return {};
+            auto pos = find(collection, obj_id);
+            if (pos == std::string_view::npos)
+            {
+                return {};
+            }
+            return collection_objects_[pos];
         }
 
         /**
@@ -822,16 +2766,18 @@ namespace tyson
          */
         template<TySonType T>
         requires (T == TySonType::ID)
-        [[ nodiscard ]] std::optional<TySonObject> get(std::string_view obj_id) noexcept
+        [[ nodiscard ]] std::optional<TySonObject> get(std::string_view obj_id) const
         {
-            for (const TySonObject &val: collection_ids_)
+            if (indexes_objects())
             {
-                if (val.value<TySonType::Link>().second == obj_id)
-                {
-                    return val;
-                }
+                return {};
             }
-            return {};
+            auto pos = find(obj_id);
+            if (pos == std::string_view::npos)
+            {
+                return {};
+            }
+            return collection_ids_[pos];
         }
 
         /**
@@ -839,22 +2785,17 @@ namespace tyson
          *
          * @tparam T TySonType::IDs
          * @param collection name
-         * @return vector of TySonObjects which belongs to the collection found by collection name
+         * @return TySonObjects which belongs to the collection in the order they were added, valid until the next add
          */
         template<TySonType T>
         requires (T == TySonType::IDs)
-        [[ nodiscard ]] std::vector<TySonObject> get(std::string_view collection) noexcept
+        [[ nodiscard ]] Entries<TySonObject> get(std::string_view collection) const
         {
-            std::vector<TySonObject> result{};
-            std::for_each(collection_ids_.begin(), collection_ids_.end(),
-                         [&result, &collection](const TySonObject &val)
-                         {
-                             if (val.value<TySonType::Link>().first == collection)
-                             {
-                                 result.emplace_back(val);
-                             }
-                         });
-            return result;
+            if (indexes_objects())
+            {
+                return {};
+            }
+            return range(collection_ids_, collection);
         }
 
         /**
@@ -867,18 +2808,18 @@ namespace tyson
          */
         template<TySonType T>
         requires (T == TySonType::ID)
-        [[ nodiscard ]] std::optional<TySonObject> get(std::string_view collection, std::string_view obj_id) noexcept
+        [[ nodiscard ]] std::optional<TySonObject> get(std::string_view collection, std::string_view obj_id) const
         {
-            for (const TySonObject &val: collection_ids_)
+            if (indexes_objects())
             {
-                auto tysonLink = val.value<TySonType::Link>();
-                if (std::tie(tysonLink.first, tysonLink.second) == std::tie(collection, obj_id))
-                {
-                    return val;
-                }
+                return {};
             }
-
-            return {};
+            auto pos = find(collection, obj_id);
+            if (pos == std::string_view::npos)
+            {
+                return {};
+            }
+            return collection_ids_[pos];
         }
     };
 }
@@ -0,0 +1,316 @@
+#ifndef ANNADB_DRIVER_TYSON_INDEX_HPP
+#define ANNADB_DRIVER_TYSON_INDEX_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ANNADB_TYSON_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace tyson
+{
+    /**
+     * The instruction sets which can be used to build a StructuralIndex
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE42,
+        AVX2,
+    };
+
+    namespace simd
+    {
+        /**
+         * Bitmasks of one 64 byte block, bit `i` stands for byte `i` of the block
+         */
+        struct BlockMasks
+        {
+            std::uint64_t bars = 0;
+            std::uint64_t structurals = 0;
+        };
+
+        /**
+         * Prefix xor of all bits, bit `i` of the result is set
+         * if an odd number of bits is set between bit 0 and bit `i`
+         */
+        inline std::uint64_t prefix_xor(std::uint64_t bits) noexcept
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        inline BlockMasks classify_scalar(const char *block) noexcept
+        {
+            BlockMasks masks;
+            for (std::uint64_t i = 0; i < 64; ++i)
+            {
+                switch (block[i])
+                {
+                    case '|':
+                        masks.bars |= std::uint64_t {1} << i;
+                        break;
+                    case ',':
+                    case ':':
+                    case '[':
+                    case ']':
+                    case '{':
+                    case '}':
+                        masks.structurals |= std::uint64_t {1} << i;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return masks;
+        }
+
+#ifdef ANNADB_TYSON_X86_SIMD
+        __attribute__((target("sse4.2")))
+        inline std::uint64_t mask_16(__m128i chunk, char chr) noexcept
+        {
+            return static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(chr))));
+        }
+
+        __attribute__((target("sse4.2")))
+        inline BlockMasks classify_sse42(const char *block) noexcept
+        {
+            BlockMasks masks;
+            for (int part = 0; part < 4; ++part)
+            {
+                auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + part * 16));
+                auto shift = static_cast<std::uint64_t>(part * 16);
+
+                masks.bars |= mask_16(chunk, '|') << shift;
+                masks.structurals |= (mask_16(chunk, ',') | mask_16(chunk, ':') |
+                                      mask_16(chunk, '[') | mask_16(chunk, ']') |
+                                      mask_16(chunk, '{') | mask_16(chunk, '}')) << shift;
+            }
+            return masks;
+        }
+
+        __attribute__((target("avx2")))
+        inline std::uint64_t mask_32(__m256i chunk, char chr) noexcept
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(chr))));
+        }
+
+        __attribute__((target("avx2")))
+        inline BlockMasks classify_avx2(const char *block) noexcept
+        {
+            BlockMasks masks;
+            for (int part = 0; part < 2; ++part)
+            {
+                auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + part * 32));
+                auto shift = static_cast<std::uint64_t>(part * 32);
+
+                masks.bars |= mask_32(chunk, '|') << shift;
+                masks.structurals |= (mask_32(chunk, ',') | mask_32(chunk, ':') |
+                                      mask_32(chunk, '[') | mask_32(chunk, ']') |
+                                      mask_32(chunk, '{') | mask_32(chunk, '}')) << shift;
+            }
+            return masks;
+        }
+#endif
+
+        /**
+         *
+         * @return the best instruction set supported by the running CPU
+         */
+        inline SimdLevel detect() noexcept
+        {
+#ifdef ANNADB_TYSON_X86_SIMD
+            static const SimdLevel level = []()
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    return SimdLevel::AVX2;
+                }
+                if (__builtin_cpu_supports("sse4.2"))
+                {
+                    return SimdLevel::SSE42;
+                }
+                return SimdLevel::Scalar;
+            }();
+            return level;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        inline BlockMasks classify(const char *block, SimdLevel level) noexcept
+        {
+#ifdef ANNADB_TYSON_X86_SIMD
+            switch (level)
+            {
+                case SimdLevel::AVX2:
+                    return classify_avx2(block);
+                case SimdLevel::SSE42:
+                    return classify_sse42(block);
+                case SimdLevel::Scalar:
+                    break;
+            }
+#else
+            static_cast<void>(level);
+#endif
+            return classify_scalar(block);
+        }
+    }
+
+    /**
+     * Positions of all structural chars `|`, `,`, `:`, `[`, `]`, `{` and `}` of a TySON string.
+     * Chars inside of a `|...|` value are not structural, so a parser can jump from one
+     * position to the next one instead of looking at every byte.
+     *
+     * exampl.: s|a,b|:v[n|1|,]
+     *           ^   ^^ ^^ ^ ^^
+     *
+     * The positions are stored as 32 bit offsets, so the input can be at most max_size chars,
+     * larger inputs are walked with StructuralIndex::scan instead.
+     */
+    class StructuralIndex
+    {
+        std::string_view input_ {};
+        std::vector<std::uint32_t> positions_ {};
+
+        void add_positions(std::uint64_t bits, std::uint32_t offset)
+        {
+            while (bits != 0)
+            {
+                positions_.emplace_back(offset + static_cast<std::uint32_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+
+        void build(SimdLevel level)
+        {
+            // most TySON responses have a structural char every few bytes
+            positions_.reserve(input_.size() / 4 + 1);
+
+            // all ones if the previous block ended inside of a `|...|` value
+            std::uint64_t inside_value = 0;
+            std::size_t offset = 0;
+            char padded[64];
+
+            while (offset < input_.size())
+            {
+                const char *block = input_.data() + offset;
+                auto remaining = input_.size() - offset;
+                std::uint64_t valid = ~std::uint64_t {0};
+
+                if (remaining < 64)
+                {
+                    std::memset(padded, ' ', sizeof(padded));
+                    std::memcpy(padded, block, remaining);
+                    block = padded;
+                    valid = (std::uint64_t {1} << remaining) - 1;
+                }
+
+                auto masks = simd::classify(block, level);
+                auto quoted = simd::prefix_xor(masks.bars) ^ inside_value;
+                inside_value = static_cast<std::uint64_t>(-static_cast<std::int64_t>(quoted >> 63));
+
+                add_positions(((masks.structurals & ~quoted) | masks.bars) & valid,
+                              static_cast<std::uint32_t>(offset));
+                offset += 64;
+            }
+        }
+
+    public:
+        // the largest input whose positions fit into the 32 bit offsets
+        static constexpr std::size_t max_size = std::numeric_limits<std::uint32_t>::max();
+
+        StructuralIndex() = default;
+
+        /**
+         * Build the index with the best instruction set of the running CPU
+         *
+         * @param input must outlive the index
+         * @throw length_error if the input is larger than max_size
+         */
+        explicit StructuralIndex(std::string_view input) : StructuralIndex(input, simd::detect()) {}
+
+        /**
+         * Build the index with a specific instruction set
+         *
+         * @param input must outlive the index
+         * @param level falls back to SimdLevel::Scalar if not available on this platform
+         * @throw length_error if the input is larger than max_size
+         */
+        StructuralIndex(std::string_view input, SimdLevel level) : input_(input)
+        {
+            if (input.size() > max_size)
+            {
+                throw std::length_error("The structural index only supports inputs of up to 4 GiB");
+            }
+            build(level);
+        }
+
+        /**
+         * Walk the same structural positions as the index without storing them, for inputs of any size
+         *
+         * @param input the TySON string
+         * @param visit called with every structural position in ascending order
+         */
+        template<typename Visit>
+        static void scan(std::string_view input, Visit &&visit)
+        {
+            bool inside_value = false;
+            for (std::size_t pos = 0; pos < input.size(); ++pos)
+            {
+                switch (input[pos])
+                {
+                    case '|':
+                        inside_value = !inside_value;
+                        visit(pos);
+                        break;
+                    case ',':
+                    case ':':
+                    case '[':
+                    case ']':
+                    case '{':
+                    case '}':
+                        if (!inside_value)
+                        {
+                            visit(pos);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        /**
+         *
+         * @return the indexed string
+         */
+        [[nodiscard]] std::string_view input() const noexcept
+        {
+            return input_;
+        }
+
+        /**
+         *
+         * @return all structural positions in ascending order
+         */
+        [[nodiscard]] const std::vector<std::uint32_t>& positions() const noexcept
+        {
+            return positions_;
+        }
+    };
+}
+
+#endif //ANNADB_DRIVER_TYSON_INDEX_HPP
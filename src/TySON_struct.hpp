@@ -0,0 +1,347 @@
+#ifndef ANNADB_DRIVER_TYSON_STRUCT_HPP
+#define ANNADB_DRIVER_TYSON_STRUCT_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "TySON.hpp"
+
+namespace tyson
+{
+    /**
+     * A string literal which can be used as template argument
+     *
+     * @tparam N size of the literal including the terminating `\0`
+     */
+    template<std::size_t N>
+    struct fixed_string
+    {
+        char chars[N] {};
+
+        constexpr fixed_string(const char (&str)[N]) noexcept
+        {
+            std::copy_n(str, N, chars);
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept
+        {
+            return {chars, N - 1};
+        }
+    };
+
+    /**
+     * One field of a struct, stored as the value of the String key `Name` inside of a AnnaDB Map
+     *
+     * @tparam Name the key inside of the Map
+     * @tparam Member pointer to the data member
+     */
+    template<fixed_string Name, auto Member>
+    requires std::is_member_object_pointer_v<decltype(Member)>
+    struct Field
+    {
+        static constexpr std::string_view name = Name.view();
+        static constexpr auto member = Member;
+
+        // `s|name|:` which is written in front of every value of the field
+        static constexpr auto key_chars = []
+        {
+            std::array<char, Name.view().size() + 4> key {'s', '|'};
+            std::copy_n(Name.view().begin(), Name.view().size(), key.begin() + 2);
+            key[key.size() - 2] = '|';
+            key[key.size() - 1] = ':';
+            return key;
+        }();
+        static constexpr std::string_view key {key_chars.data(), key_chars.size()};
+    };
+
+    /**
+     * The list of fields of a struct, base of every Describe specialization
+     */
+    template<typename... F>
+    struct Fields
+    {
+        static constexpr std::size_t size = sizeof...(F);
+    };
+
+    /**
+     * Describe the fields of a struct once to decode it from AnnaDB Maps and to encode it into them
+     *
+     * exampl.:
+     *      struct User { std::string name; int age; };
+     *
+     *      template<>
+     *      struct tyson::Describe<User> : tyson::Fields<tyson::Field<"name", &User::name>,
+     *                                                   tyson::Field<"age", &User::age>>
+     *      {};
+     *
+     * Supported field types are arithmetic types, std::string, tyson::Uuid for Links (decoding only),
+     * tyson::TySonObject, std::optional, std::vector and other described structs.
+     */
+    template<typename T>
+    struct Describe;
+
+    template<typename T>
+    concept Described = requires { Describe<T>::size; };
+
+    template<typename T>
+    struct is_optional : std::false_type {};
+
+    template<typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    template<typename T>
+    struct is_vector : std::false_type {};
+
+    template<typename T, typename Alloc>
+    struct is_vector<std::vector<T, Alloc>> : std::true_type {};
+
+    /**
+     * Call fn with every Field of a described struct, the list is known at compile time
+     *
+     * @return true if fn returned true for one of the fields, the remaining ones are skipped
+     */
+    template<Described T, typename Fn>
+    constexpr bool for_each_field(Fn &&fn)
+    {
+        return []<typename... F>(Fields<F...>, Fn &call)
+        {
+            return (... || call(F {}));
+        }(Describe<T> {}, fn);
+    }
+
+    namespace decoding
+    {
+        inline void expect(const TySonToken &token, TySonType type)
+        {
+            if (token.type != type)
+            {
+                std::stringstream sstream;
+                sstream << "Expected " << TySonType_repr(type) << " but got " << TySonType_repr(token.type);
+                throw std::invalid_argument(sstream.str());
+            }
+        }
+    }
+
+    template<typename T>
+    void decode(const TySonToken &token, T &out);
+
+    /**
+     * Decode the entries of a AnnaDB Map into a described struct,
+     * fields without an entry keep their value and entries without a field are skipped
+     *
+     * @param body the body between the brackets of the Map
+     * @param out the struct to fill
+     */
+    template<Described T>
+    void decode_fields(std::string_view body, T &out)
+    {
+        TySonParser parser {body};
+        while (!parser.container_closed('}'))
+        {
+            auto key = parser.next();
+            if (!parser.consume(':'))
+            {
+                break;
+            }
+            auto entry = parser.next();
+
+            if (key.type != TySonType::String)
+            {
+                continue;
+            }
+            for_each_field<T>([&key, &entry, &out](auto field)
+                              {
+                                  if (key.value != decltype(field)::name)
+                                  {
+                                      return false;
+                                  }
+                                  decode(entry, out.*decltype(field)::member);
+                                  return true;
+                              });
+        }
+    }
+
+    /**
+     * Decode a single value found by the TySonParser without building a TySonObject
+     *
+     * @param token the value
+     * @param out will be overwritten with the decoded value
+     * @throw invalid_argument if the value does not fit to the type of out
+     */
+    template<typename T>
+    void decode(const TySonToken &token, T &out)
+    {
+        if constexpr (Described<T>)
+        {
+            decoding::expect(token, TySonType::Map);
+            decode_fields(token.value, out);
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            decoding::expect(token, TySonType::Bool);
+            out = token.value == "true";
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            if (token.type != TySonType::Timestamp)
+            {
+                decoding::expect(token, TySonType::Number);
+            }
+
+            const auto *end = token.value.data() + token.value.size();
+            auto [ptr, ec] = std::from_chars(token.value.data(), end, out);
+            if (ec != std::errc() || ptr != end)
+            {
+                throw std::invalid_argument("Invalid Number: " + std::string(token.value));
+            }
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            decoding::expect(token, TySonType::String);
+            out.assign(token.value);
+        }
+        else if constexpr (std::is_same_v<T, Uuid>)
+        {
+            decoding::expect(token, TySonType::Link);
+            auto uuid = Uuid::parse(token.value);
+            if (!uuid)
+            {
+                throw std::invalid_argument("Invalid Uuid: " + std::string(token.value));
+            }
+            out = *uuid;
+        }
+        else if constexpr (std::is_same_v<T, TySonObject>)
+        {
+            out = TySonParser::parse(token);
+        }
+        else if constexpr (is_optional<T>::value)
+        {
+            if (token.type == TySonType::Null)
+            {
+                out.reset();
+                return;
+            }
+            decode(token, out.emplace());
+        }
+        else if constexpr (is_vector<T>::value)
+        {
+            decoding::expect(token, TySonType::Vector);
+            out.clear();
+            TySonParser parser {token.value};
+            while (!parser.container_closed(']'))
+            {
+                decode(parser.next(), out.emplace_back());
+            }
+        }
+        else
+        {
+            static_assert(!sizeof(T), "the type can not be decoded from TySON, describe it with tyson::Describe");
+        }
+    }
+
+    /**
+     * Decode a raw AnnaDB(TySON) value
+     *
+     * exampl.: tyson::decode<User>("m{s|name|:s|jondoe|,s|age|:n|42|,}")
+     *
+     * @tparam T the type to decode into
+     * @param raw the TySON string
+     * @return the decoded value
+     */
+    template<typename T>
+    [[nodiscard]] T decode(std::string_view raw)
+    {
+        T out {};
+        TySonParser parser {raw};
+        decode(parser.next(), out);
+        return out;
+    }
+    /**
+     * Append the AnnaDB(TySON) representation of a value without building a TySonObject,
+     * described structs are written as Map with their fields in the order of the description
+     *
+     * exampl.: User {"jondoe", 42} => m{s|name|:s|jondoe|,s|age|:n|42|,}
+     *
+     * @param value the value to encode
+     * @param writer the encoded value is appended to it
+     */
+    template<typename T>
+    void encode(const T &value, Writer &writer)
+    {
+        if constexpr (Described<T>)
+        {
+            writer.begin_map();
+            for_each_field<T>([&value, &writer](auto field)
+                              {
+                                  writer.raw(decltype(field)::key);
+                                  encode(value.*decltype(field)::member, writer);
+                                  writer.separator();
+                                  return false;
+                              });
+            writer.end_map();
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            writer.boolean(value);
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            writer.number(value);
+        }
+        else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            writer.string(value);
+        }
+        else if constexpr (std::is_same_v<T, TySonObject>)
+        {
+            writer.value(value);
+        }
+        else if constexpr (is_optional<T>::value)
+        {
+            if (value)
+            {
+                encode(*value, writer);
+            }
+            else
+            {
+                writer.null();
+            }
+        }
+        else if constexpr (is_vector<T>::value)
+        {
+            writer.begin_vector();
+            for (const auto &element : value)
+            {
+                encode(element, writer);
+                writer.separator();
+            }
+            writer.end_vector();
+        }
+        else
+        {
+            static_assert(!sizeof(T), "the type can not be encoded as TySON, describe it with tyson::Describe");
+        }
+    }
+
+    /**
+     * Encode a value into a new AnnaDB(TySON) string
+     *
+     * @param value the value to encode
+     * @return the TySON string
+     */
+    template<typename T>
+    [[nodiscard]] std::string encode(const T &value)
+    {
+        Writer writer {};
+        encode(value, writer);
+        return writer.take();
+    }
+}
+
+#endif //ANNADB_DRIVER_TYSON_STRUCT_HPP
@@ -0,0 +1,148 @@
+#ifndef ANNADB_DRIVER_TYSON_UUID_HPP
+#define ANNADB_DRIVER_TYSON_UUID_HPP
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace tyson
+{
+    /**
+     * The id of an AnnaDB object as 16 bytes instead of its 36 char text
+     * exampl.: e0bbcda2-0911-495e-9f0f-ce00db489f10
+     *
+     * Only the lower case text is parsed, so formatting a parsed Uuid always gives back the same text.
+     */
+    class Uuid
+    {
+        std::array<std::uint8_t, 16> bytes_ {};
+
+        static constexpr std::size_t text_size = 36;
+
+        static constexpr bool is_dash(std::size_t pos) noexcept
+        {
+            return pos == 8 || pos == 13 || pos == 18 || pos == 23;
+        }
+
+        static constexpr int hex_value(char chr) noexcept
+        {
+            if (chr >= '0' && chr <= '9')
+            {
+                return chr - '0';
+            }
+            if (chr >= 'a' && chr <= 'f')
+            {
+                return chr - 'a' + 10;
+            }
+            return -1;
+        }
+
+    public:
+        Uuid() = default;
+
+        /**
+         * Parse the text representation of a uuid
+         *
+         * @param text exampl.: e0bbcda2-0911-495e-9f0f-ce00db489f10
+         * @return the Uuid if text is a lower case uuid
+         */
+        [[nodiscard]] static std::optional<Uuid> parse(std::string_view text) noexcept
+        {
+            if (text.size() != text_size)
+            {
+                return {};
+            }
+
+            Uuid uuid;
+            std::size_t byte = 0;
+            for (std::size_t pos = 0; pos < text_size; pos += 2)
+            {
+                if (is_dash(pos))
+                {
+                    if (text[pos] != '-')
+                    {
+                        return {};
+                    }
+                    ++pos;
+                }
+
+                auto high = hex_value(text[pos]);
+                auto low = hex_value(text[pos + 1]);
+                if (high < 0 || low < 0)
+                {
+                    return {};
+                }
+                uuid.bytes_[byte++] = static_cast<std::uint8_t>(high << 4 | low);
+            }
+            return uuid;
+        }
+
+        /**
+         * Write the text representation
+         *
+         * @param out must have space for 36 chars
+         * @return the position behind the written text
+         */
+        char* format(char *out) const noexcept
+        {
+            constexpr std::string_view digits = "0123456789abcdef";
+            std::size_t pos = 0;
+            for (auto byte : bytes_)
+            {
+                if (is_dash(pos))
+                {
+                    out[pos++] = '-';
+                }
+                out[pos++] = digits[byte >> 4];
+                out[pos++] = digits[byte & 0x0f];
+            }
+            return out + text_size;
+        }
+
+        /**
+         *
+         * @return the text representation, exampl.: e0bbcda2-0911-495e-9f0f-ce00db489f10
+         */
+        [[nodiscard]] std::string str() const
+        {
+            std::string text(text_size, '\0');
+            format(text.data());
+            return text;
+        }
+
+        [[nodiscard]] const std::array<std::uint8_t, 16>& bytes() const noexcept
+        {
+            return bytes_;
+        }
+
+        auto operator<=>(const Uuid &) const = default;
+
+        friend std::ostream& operator<<(std::ostream &out, const Uuid &uuid)
+        {
+            char text[text_size];
+            uuid.format(text);
+            return out.write(text, text_size);
+        }
+    };
+}
+
+template<>
+struct std::hash<tyson::Uuid>
+{
+    std::size_t operator()(const tyson::Uuid &uuid) const noexcept
+    {
+        // uuids are random already, mixing both halves is enough
+        std::uint64_t high;
+        std::uint64_t low;
+        std::memcpy(&high, uuid.bytes().data(), sizeof(high));
+        std::memcpy(&low, uuid.bytes().data() + sizeof(high), sizeof(low));
+        return static_cast<std::size_t>(high ^ (low * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+#endif //ANNADB_DRIVER_TYSON_UUID_HPP
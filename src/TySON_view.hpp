@@ -0,0 +1,460 @@
+#ifndef ANNADB_DRIVER_TYSON_VIEW_HPP
+#define ANNADB_DRIVER_TYSON_VIEW_HPP
+
+#include <charconv>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include "TySON.hpp"
+
+namespace tyson
+{
+    /**
+     * Read-only, ref-counted storage of a raw AnnaDB response.
+     * The owner can be anything which keeps the bytes alive, e.g. the received zmq::message_t,
+     * so that all views into one response share a single allocation.
+     */
+    class SharedBuffer
+    {
+        std::shared_ptr<const void> owner_ {};
+        std::string_view data_ {};
+
+    public:
+        SharedBuffer() = default;
+
+        /**
+         * Create a new SharedBuffer from an already existing owner
+         *
+         * @param owner keeps the memory of data alive
+         * @param data the bytes owned by owner
+         */
+        SharedBuffer(std::shared_ptr<const void> owner, std::string_view data) noexcept : owner_(std::move(owner)),
+                                                                                            data_(data)
+        {}
+
+        /**
+         * Create a new SharedBuffer which owns a copy of the data
+         *
+         * @param data raw AnnaDB response
+         * @return new SharedBuffer
+         */
+        [[nodiscard]] static SharedBuffer copy(std::string_view data)
+        {
+            auto owner = std::make_shared<const std::string>(data);
+            std::string_view view {*owner};
+            return {std::move(owner), view};
+        }
+
+        /**
+         *
+         * @return the owned bytes, valid as long as any copy of this buffer exists
+         */
+        [[nodiscard]] std::string_view view() const noexcept
+        {
+            return data_;
+        }
+    };
+
+    class ScalarView;
+    class LinkView;
+    class VectorView;
+    class MapView;
+
+    /**
+     * Read-only view of any AnnaDB(TySON) value.
+     * A view does not own anything, it stays valid as long as the buffer it points into,
+     * use `to_owned()` to get a TySonObject which can outlive it.
+     */
+    class TySonView
+    {
+    protected:
+        TySonToken token_ {};
+
+        void expect(TySonType type) const
+        {
+            if (token_.type != type)
+            {
+                throw std::invalid_argument(std::string("Can not be used with ") +
+                                            std::string(TySonType_repr(token_.type)));
+            }
+        }
+
+    public:
+        TySonView() = default;
+        explicit TySonView(const TySonToken &token) noexcept : token_(token) {}
+
+        /**
+         * Create a view of the first value inside of a raw AnnaDB(TySON) string
+         *
+         * @param raw must outlive the view
+         * @return new TySonView
+         */
+        [[nodiscard]] static TySonView parse(std::string_view raw) noexcept
+        {
+            TySonParser parser {raw};
+            return TySonView {parser.next()};
+        }
+
+        /**
+         *
+         * @return the type of the viewed value
+         */
+        [[nodiscard]] TySonType type() const noexcept
+        {
+            return token_.type;
+        }
+
+        /**
+         *
+         * @return the viewed value in it's TySON format
+         */
+        [[nodiscard]] std::string_view raw() const noexcept
+        {
+            return token_.raw;
+        }
+
+        /**
+         *
+         * @return the underlying token
+         */
+        [[nodiscard]] const TySonToken& token() const noexcept
+        {
+            return token_;
+        }
+
+        /**
+         * Copy the viewed value into a TySonObject
+         *
+         * @param alloc used for the new TySonObject and all nested values
+         * @return new TySonObject
+         */
+        [[nodiscard]] TySonObject to_owned(const TySonObject::allocator_type &alloc = {}) const noexcept
+        {
+            return TySonParser::parse(token_, alloc);
+        }
+
+        [[nodiscard]] ScalarView scalar() const;
+        [[nodiscard]] LinkView link() const;
+        [[nodiscard]] VectorView vector() const;
+        [[nodiscard]] MapView map() const;
+    };
+
+    /**
+     * View of a Number, String, Bool, Timestamp or Null
+     */
+    class ScalarView : public TySonView
+    {
+    public:
+        ScalarView() = default;
+        explicit ScalarView(const TySonToken &token) noexcept : TySonView(token) {}
+
+        /**
+         *
+         * @return the value between the `|`
+         */
+        [[nodiscard]] std::string_view value() const noexcept
+        {
+            return token_.value;
+        }
+
+        /**
+         * Parse the value into an arithmetic type without copying it
+         *
+         * @tparam T must be a arithmetic type
+         * @return the parsed value
+         * @throw invalid_argument if the value is not a Number, Bool or Timestamp or not all of it is a T, exampl.: n|1.5| as int
+         * @throw out_of_range if the number does not fit into T
+         */
+        template<typename T>
+        requires std::is_arithmetic_v<T>
+        [[nodiscard]] T value() const
+        {
+            if (token_.type == TySonType::Bool)
+            {
+                return static_cast<T>(token_.value == "true");
+            }
+
+            if (token_.type == TySonType::Number || token_.type == TySonType::Timestamp)
+            {
+                auto begin = token_.value.data();
+                auto end = begin + token_.value.size();
+
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    return false;
+                }
+                else
+                {
+                    T result {};
+                    auto [ptr, ec] = std::from_chars(begin, end, result);
+                    if (ec == std::errc::result_out_of_range)
+                    {
+                        throw std::out_of_range("Number out of range: " + std::string(token_.value));
+                    }
+                    if (ec != std::errc() || ptr != end)
+                    {
+                        throw std::invalid_argument("Invalid Number: " + std::string(token_.value));
+                    }
+                    return result;
+                }
+            }
+
+            throw std::invalid_argument("Invalid Type");
+        }
+    };
+
+    /**
+     * View of a Link
+     * exampl.: users|e0bbcda2-0911-495e-9f0f-ce00db489f10|
+     */
+    class LinkView : public TySonView
+    {
+    public:
+        LinkView() = default;
+        explicit LinkView(const TySonToken &token) noexcept : TySonView(token) {}
+
+        /**
+         *
+         * @return the name of the collection
+         */
+        [[nodiscard]] std::string_view collection() const noexcept
+        {
+            return token_.tag;
+        }
+
+        /**
+         *
+         * @return the uuid-string of the linked object
+         */
+        [[nodiscard]] std::string_view id() const noexcept
+        {
+            return token_.value;
+        }
+    };
+
+    /**
+     * Lazy view of a Vector, the elements are found while iterating
+     * exampl.: v[n|1|,n|2|,n|3|,]
+     */
+    class VectorView : public TySonView
+    {
+    public:
+        class Iterator
+        {
+            TySonParser parser_ {{}};
+            TySonView current_ {};
+            bool done_ = true;
+
+            void advance() noexcept
+            {
+                done_ = parser_.container_closed(']');
+                if (!done_)
+                {
+                    current_ = TySonView {parser_.next()};
+                }
+            }
+
+        public:
+            using value_type = TySonView;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            explicit Iterator(std::string_view body) noexcept : parser_(body), done_(false)
+            {
+                advance();
+            }
+
+            const TySonView& operator*() const noexcept
+            {
+                return current_;
+            }
+
+            const TySonView* operator->() const noexcept
+            {
+                return &current_;
+            }
+
+            Iterator& operator++() noexcept
+            {
+                advance();
+                return *this;
+            }
+
+            void operator++(int) noexcept
+            {
+                advance();
+            }
+
+            friend bool operator==(const Iterator &it, std::default_sentinel_t) noexcept
+            {
+                return it.done_;
+            }
+        };
+
+        VectorView() = default;
+        explicit VectorView(const TySonToken &token) noexcept : TySonView(token) {}
+
+        [[nodiscard]] Iterator begin() const noexcept
+        {
+            return Iterator {token_.value};
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+        /**
+         * Count the elements, this walks the whole Vector
+         *
+         * @return number of elements
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            std::size_t result = 0;
+            for (auto it = begin(); it != end(); ++it)
+            {
+                ++result;
+            }
+            return result;
+        }
+    };
+
+    /**
+     * Lazy view of a Map, the entries are found while iterating
+     * exampl.: m{s|bar|:s|baz|,}
+     */
+    class MapView : public TySonView
+    {
+    public:
+        class Iterator
+        {
+            TySonParser parser_ {{}};
+            std::pair<TySonView, TySonView> current_ {};
+            bool done_ = true;
+
+            void advance() noexcept
+            {
+                done_ = parser_.container_closed('}');
+                if (!done_)
+                {
+                    current_.first = TySonView {parser_.next()};
+                    current_.second = parser_.consume(':') ? TySonView {parser_.next()} : TySonView {};
+                }
+            }
+
+        public:
+            using value_type = std::pair<TySonView, TySonView>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            explicit Iterator(std::string_view body) noexcept : parser_(body), done_(false)
+            {
+                advance();
+            }
+
+            const value_type& operator*() const noexcept
+            {
+                return current_;
+            }
+
+            const value_type* operator->() const noexcept
+            {
+                return &current_;
+            }
+
+            Iterator& operator++() noexcept
+            {
+                advance();
+                return *this;
+            }
+
+            void operator++(int) noexcept
+            {
+                advance();
+            }
+
+            friend bool operator==(const Iterator &it, std::default_sentinel_t) noexcept
+            {
+                return it.done_;
+            }
+        };
+
+        MapView() = default;
+        explicit MapView(const TySonToken &token) noexcept : TySonView(token) {}
+
+        [[nodiscard]] Iterator begin() const noexcept
+        {
+            return Iterator {token_.value};
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+        /**
+         * Get the value of a AnnaDB Map entry by the value of it's key
+         *
+         * @param key the value of the key, exampl.: `bar` for s|bar|
+         * @return the view of the value if found
+         */
+        [[nodiscard]] std::optional<TySonView> operator[](std::string_view key) const noexcept
+        {
+            for (const auto &[entry_key, entry_value] : *this)
+            {
+                if (entry_key.token().value == key)
+                {
+                    return entry_value;
+                }
+            }
+            return {};
+        }
+
+        /**
+         * Count the entries, this walks the whole Map
+         *
+         * @return number of entries
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            std::size_t result = 0;
+            for (auto it = begin(); it != end(); ++it)
+            {
+                ++result;
+            }
+            return result;
+        }
+    };
+
+    inline ScalarView TySonView::scalar() const
+    {
+        if (token_.type != TySonType::Number && token_.type != TySonType::String && token_.type != TySonType::Bool &&
+            token_.type != TySonType::Timestamp && token_.type != TySonType::Null)
+        {
+            expect(TySonType::String);
+        }
+        return ScalarView {token_};
+    }
+
+    inline LinkView TySonView::link() const
+    {
+        expect(TySonType::Link);
+        return LinkView {token_};
+    }
+
+    inline VectorView TySonView::vector() const
+    {
+        expect(TySonType::Vector);
+        return VectorView {token_};
+    }
+
+    inline MapView TySonView::map() const
+    {
+        expect(TySonType::Map);
+        return MapView {token_};
+    }
+}
+
+#endif //ANNADB_DRIVER_TYSON_VIEW_HPP
@@ -0,0 +1,218 @@
+#include <regex>
+#include <benchmark/benchmark.h>
+#include "../connection.hpp"
+
+/**
+ * Build the data part of a find response with `entries` objects
+ *
+ * @param entries number of objects
+ * @return the raw TySON string
+ */
+static std::string objects_response(std::size_t entries)
+{
+    std::string raw = "s|data|:objects{";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        raw += "test|d08412fb-9d7e-4d8f-8905-" + std::string(12 - num.size(), '0') + num + "|:m{"
+               "s|num|:n|" + num + "|,"
+               "s|name|:s|test_" + num + "|,"
+               "s|tags|:v[s|a|,s|b|,],"
+               "},";
+    }
+    raw += "}";
+    return raw;
+}
+
+/**
+ * The regex based split which was used by annadb::Data before the scanner,
+ * kept here to compare both ways of finding the entries
+ */
+static std::vector<std::pair<std::string, std::string>> regex_split(std::string_view str_data)
+{
+    static const std::regex pattern ("(,)\\b[\\w-]{2,}+\\b\\|");
+
+    auto new_data = std::regex_replace(std::string(str_data), pattern, "^$&");
+    auto data = utils::split(new_data, '^');
+
+    std::vector<std::pair<std::string, std::string>> parts {};
+    parts.reserve(data.size());
+    for (auto &part : data)
+    {
+        auto separation = part.find_first_of(':');
+        auto start = part[0] == ',' ? 1 : 0;
+        auto end = part[part.size() - 1] == ',' ? 1 : 0;
+        parts.emplace_back(part.substr(start, separation - start),
+                           part.substr(separation + 1, part.size() - 1 - separation - end));
+    }
+    return parts;
+}
+
+static void BM_objects_regex(benchmark::State &state)
+{
+    auto raw = objects_response(static_cast<std::size_t>(state.range(0)));
+    auto start_val = raw.find_first_of('{') + 1;
+    auto end_val = raw.find_last_of('}');
+
+    for (auto _ : state)
+    {
+        auto parts = regex_split(std::string_view(raw).substr(start_val, end_val - start_val));
+        tyson::TySonCollectionObject object {parts.size(), true};
+        for (auto &[link, value] : parts)
+        {
+            object.add(link, value);
+        }
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_objects_regex)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+static void BM_objects_scanner(benchmark::State &state)
+{
+    auto raw = objects_response(static_cast<std::size_t>(state.range(0)));
+    annadb::Data data {raw};
+
+    for (auto _ : state)
+    {
+        auto object = data.get<tyson::TySonType::Objects>();
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_objects_scanner)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+struct Entry
+{
+    long num = 0;
+    std::string name;
+    std::vector<std::string> tags;
+};
+
+template<>
+struct tyson::Describe<Entry> : tyson::Fields<tyson::Field<"num", &Entry::num>,
+                                              tyson::Field<"name", &Entry::name>,
+                                              tyson::Field<"tags", &Entry::tags>>
+{};
+
+static void BM_objects_to_structs_by_hand(benchmark::State &state)
+{
+    auto raw = objects_response(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        // the collection is cached by Data, build it again every iteration
+        annadb::Data data {raw};
+        std::vector<Entry> entries;
+        for (const auto &[link, value] : data.get<tyson::TySonType::Objects>()->get<tyson::TySonType::Objects>("test"))
+        {
+            auto &entry = entries.emplace_back();
+            entry.num = value["num"]->value<long>();
+            entry.name = value["name"]->value<tyson::TySonType::String>();
+            for (const auto &tag : value["tags"]->value<tyson::TySonType::Vector>())
+            {
+                entry.tags.emplace_back(tag.value<tyson::TySonType::String>());
+            }
+        }
+        benchmark::DoNotOptimize(entries);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_objects_to_structs_by_hand)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+static void BM_objects_decode(benchmark::State &state)
+{
+    auto raw = objects_response(static_cast<std::size_t>(state.range(0)));
+    annadb::Data data {raw};
+
+    for (auto _ : state)
+    {
+        auto entries = data.decode<Entry>("test");
+        benchmark::DoNotOptimize(entries);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_objects_decode)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+/**
+ * Build the data part of an insert response with `entries` links
+ *
+ * @param entries number of links
+ * @return the raw TySON string
+ */
+static std::string ids_response(std::size_t entries)
+{
+    std::string raw = "s|data|:ids[";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        raw += "test|d08412fb-9d7e-4d8f-8905-" + std::string(12 - num.size(), '0') + num + "|,";
+    }
+    raw += "]";
+    return raw;
+}
+
+static void BM_ids_lookup(benchmark::State &state)
+{
+    auto entries = static_cast<std::size_t>(state.range(0));
+    auto raw = ids_response(entries);
+
+    for (auto _ : state)
+    {
+        // the collection is cached by Data, build it again every iteration
+        annadb::Data data {raw};
+        const auto &ids = data.get<tyson::TySonType::IDs>();
+        for (std::size_t i = 0; i < entries; i += 16)
+        {
+            auto num = std::to_string(i);
+            auto id = "d08412fb-9d7e-4d8f-8905-" + std::string(12 - num.size(), '0') + num;
+            benchmark::DoNotOptimize(ids->get<tyson::TySonType::ID>("test", id));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ids_lookup)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+/**
+ * Merge the responses of a get which was split into sub requests of 10000 links
+ */
+static void BM_merge_get_responses(benchmark::State &state)
+{
+    constexpr std::size_t max_links = 10000;
+    auto entries = static_cast<std::size_t>(state.range(0));
+    auto response = objects_response(entries);
+
+    std::vector<std::string> link_texts {};
+    std::vector<tyson::TySonObject> links {};
+    links.reserve(entries);
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        link_texts.push_back("test|d08412fb-9d7e-4d8f-8905-" + std::string(12 - num.size(), '0') + num + "|");
+        links.emplace_back(link_texts.back());
+    }
+
+    // every sub request answers with the objects of its links
+    std::vector<annadb::Journal> responses {};
+    for (std::size_t first = 0; first < entries; first += max_links)
+    {
+        auto last = std::min(first + max_links, entries);
+        auto begin = response.find(link_texts[first]);
+        auto end = last == entries ? response.size() - 1 : response.find(link_texts[last]);
+        responses.emplace_back("result:ok[response{s|data|:objects{" + response.substr(begin, end - begin) +
+                               "},s|meta|:get_meta{s|count|:n|0|,},},];");
+    }
+
+    for (auto _ : state)
+    {
+        auto merged = annadb::merge_get_responses(links, responses, max_links);
+        benchmark::DoNotOptimize(merged);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_merge_get_responses)->RangeMultiplier(8)->Range(8, 1 << 18);
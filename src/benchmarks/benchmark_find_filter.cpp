@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+#include "../query.hpp"
+
+static void BM_find_predicates(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        annadb::Query::Find find {};
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            find.gt("num", tyson::TySonObject::Number(i));
+        }
+        benchmark::DoNotOptimize(find.query());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_find_predicates)->RangeMultiplier(16)->Range(16, 1 << 14);
+
+static void BM_find_nested_predicates(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        annadb::Query::Find find {};
+        for (int64_t i = 0; i < state.range(0); i += 2)
+        {
+            find.q(annadb::Query::Or(annadb::Query::And(annadb::Query::Gt("num", tyson::TySonObject::Number(i)),
+                                                        annadb::Query::Lt("num", tyson::TySonObject::Number(i + 1)))));
+        }
+        benchmark::DoNotOptimize(find.query());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_find_nested_predicates)->RangeMultiplier(16)->Range(16, 1 << 14);
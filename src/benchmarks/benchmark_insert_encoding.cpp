@@ -0,0 +1,98 @@
+#include <ranges>
+#include <benchmark/benchmark.h>
+#include "../query.hpp"
+
+struct Record
+{
+    long num = 0;
+    double price = 0;
+    std::string name;
+    bool active = false;
+};
+
+template<>
+struct tyson::Describe<Record> : tyson::Fields<tyson::Field<"num", &Record::num>,
+                                               tyson::Field<"price", &Record::price>,
+                                               tyson::Field<"name", &Record::name>,
+                                               tyson::Field<"active", &Record::active>>
+{};
+
+static std::vector<Record> records(std::size_t entries)
+{
+    std::vector<Record> result;
+    result.reserve(entries);
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        result.push_back({static_cast<long>(i), static_cast<double>(i) + 0.25, "name_" + std::to_string(i), i % 2 == 0});
+    }
+    return result;
+}
+
+/**
+ * Build a TySonObject Map for every record, like it was needed before the records could be described
+ */
+static void BM_insert_tyson_objects(benchmark::State &state)
+{
+    auto data = records(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<tyson::TySonObject> objects;
+        objects.reserve(data.size());
+        for (const auto &record : data)
+        {
+            std::map<std::string, tyson::TySonObject> fields {
+                    {"num", tyson::TySonObject::Number(record.num)},
+                    {"price", tyson::TySonObject::Number(record.price)},
+                    {"name", tyson::TySonObject::String(record.name)},
+                    {"active", tyson::TySonObject::Bool(record.active)},
+            };
+            objects.emplace_back(tyson::TySonObject::Map(fields));
+        }
+
+        auto query = annadb::Query::Query("test");
+        query.insert(objects);
+        std::stringstream sstream;
+        sstream << query;
+        benchmark::DoNotOptimize(sstream.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_insert_tyson_objects)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_insert_structs(benchmark::State &state)
+{
+    auto data = records(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto query = annadb::Query::Query("test");
+        query.insert(std::span<const Record> {data});
+        std::stringstream sstream;
+        sstream << query;
+        benchmark::DoNotOptimize(sstream.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_insert_structs)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * The records are created while the query is written, they never exist in a vector
+ */
+static void BM_insert_range(benchmark::State &state)
+{
+    auto generated = std::views::iota(0L, state.range(0))
+                     | std::views::transform([](long i)
+                                             {
+                                                 return Record {i, static_cast<double>(i) + 0.25,
+                                                                "name_" + std::to_string(i), i % 2 == 0};
+                                             });
+    for (auto _ : state)
+    {
+        auto query = annadb::Query::Query("test");
+        query.insert(generated);
+        // the buffer the records were encoded into is the written query
+        auto written = std::move(query).write();
+        benchmark::DoNotOptimize(written.view().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_insert_range)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include "../query.hpp"
+#include "../query_static.hpp"
+
+static void BM_rebuild_query(benchmark::State &state)
+{
+    int64_t user_id = 0;
+    for (auto _ : state)
+    {
+        auto query = annadb::Query::Query("users");
+        query.find(annadb::Query::Find::GT(tyson::TySonObject::Number(++user_id))).limit(10);
+
+        tyson::Writer writer {};
+        query.write(writer);
+        benchmark::DoNotOptimize(writer.view());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_rebuild_query);
+
+static void BM_bind_prepared_query(benchmark::State &state)
+{
+    annadb::Query::Find find {};
+    find.q(annadb::Query::Gt(annadb::Query::Param {0}));
+    auto query = annadb::Query::Query("users");
+    query.find(std::move(find)).limit(annadb::Query::Param {1});
+    const auto prepared = query.prepare();
+
+    int64_t user_id = 0;
+    for (auto _ : state)
+    {
+        auto writer = prepared.bind(++user_id, 10);
+        benchmark::DoNotOptimize(writer.view());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_bind_prepared_query);
+
+static void BM_write_static_query(benchmark::State &state)
+{
+    using namespace annadb::Query::Static;
+    using UsersQuery = StaticQuery<"users", Find<Gt<>>, Limit<>>;
+
+    int64_t user_id = 0;
+    for (auto _ : state)
+    {
+        auto writer = UsersQuery::bind(++user_id, 10);
+        benchmark::DoNotOptimize(writer.view());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_write_static_query);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include "../TySON.hpp"
+
+/**
+ * The members every TySonObject carried before it was a tagged union,
+ * only used to report how much memory one element needed before
+ */
+struct LegacyTySonObject
+{
+    std::vector<LegacyTySonObject> vector_ {};
+    std::map<int, LegacyTySonObject> map_ {};
+    std::pair<std::string, std::string> link_ {};
+    tyson::TySonType type_ = tyson::TySonType::Null;
+    std::string value_ {};
+};
+
+/**
+ * Build a TySON Vector of `entries` scalars, mostly numbers and a few links and strings
+ *
+ * @param entries number of scalars
+ * @return the raw TySON string
+ */
+static std::string scalars(std::size_t entries)
+{
+    std::string raw = "v[";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        switch (i % 4)
+        {
+            case 0:
+                raw += "s|name_" + std::to_string(i) + "|,";
+                break;
+            case 1:
+                raw += "users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,";
+                break;
+            default:
+                raw += "n|" + std::to_string(i) + "|,";
+                break;
+        }
+    }
+    raw += "]";
+    return raw;
+}
+
+static void BM_parse_scalars(benchmark::State &state)
+{
+    auto raw = scalars(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        tyson::TySonObject object {raw};
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] = sizeof(tyson::TySonObject);
+    state.counters["legacy_bytes_per_element"] = sizeof(LegacyTySonObject);
+}
+BENCHMARK(BM_parse_scalars)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "../TySON.hpp"
+
+/**
+ * Build a TySON Vector of `entries` maps with an integer, a floating point number and a timestamp
+ *
+ * @param entries number of maps inside of the vector
+ * @return the raw TySON string
+ */
+static std::string numeric_rows(std::size_t entries)
+{
+    std::string raw = "v[";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        raw += "m{s|id|:n|" + num + "|,s|price|:n|" + num + ".25|,s|created|:uts|16766632" + num + "|,},";
+    }
+    raw += "]";
+    return raw;
+}
+
+static void BM_parse_numeric_rows(benchmark::State &state)
+{
+    auto raw = numeric_rows(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        tyson::TySonObject object {raw};
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_parse_numeric_rows)->RangeMultiplier(16)->Range(1 << 4, 1 << 14);
+
+static void BM_sum_numbers(benchmark::State &state)
+{
+    std::string raw = "v[";
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        raw += i % 2 ? "n|" + std::to_string(i) + "|," : "n|" + std::to_string(i) + ".25|,";
+    }
+    raw += "]";
+    auto numbers = tyson::TySonObject {raw}.value<tyson::TySonType::Vector>();
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (const auto &number : numbers)
+        {
+            sum += number.value<double>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_sum_numbers)->RangeMultiplier(16)->Range(1 << 4, 1 << 14);
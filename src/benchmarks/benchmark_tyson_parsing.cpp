@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include "../TySON.hpp"
+
+/**
+ * Build a TySON Vector with `entries` nested maps which look like the values of a find response
+ *
+ * @param entries number of maps inside of the vector
+ * @return the raw TySON string
+ */
+static std::string nested_maps(std::size_t entries)
+{
+    std::string raw = "v[";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        raw += "m{s|num|:n|" + num + "|,"
+               "s|name|:s|name_" + num + ", with: separators|,"
+               "s|tags|:v[s|a|,s|b|,s|c|,],"
+               "s|nested|:m{s|active|:b|true|,s|created|:uts|1676663261|,s|ref|:users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,},"
+               "},";
+    }
+    raw += "]";
+    return raw;
+}
+
+static void BM_parse_nested_maps(benchmark::State &state)
+{
+    auto raw = nested_maps(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        tyson::TySonObject object{raw};
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetComplexityN(static_cast<int64_t>(raw.size()));
+}
+BENCHMARK(BM_parse_nested_maps)->RangeMultiplier(4)->Range(1 << 6, 1 << 14)->Complexity(benchmark::oN);
+
+static void BM_parse_deep_nesting(benchmark::State &state)
+{
+    std::string raw;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        raw += "m{s|level|:n|" + std::to_string(i) + "|,s|child|:";
+    }
+    raw += "null";
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        raw += ",}";
+    }
+
+    for (auto _ : state)
+    {
+        tyson::TySonObject object{raw};
+        benchmark::DoNotOptimize(object);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.SetComplexityN(static_cast<int64_t>(raw.size()));
+}
+BENCHMARK(BM_parse_deep_nesting)->RangeMultiplier(4)->Range(1 << 4, 1 << 10)->Complexity(benchmark::oN);
+
+static void BM_structural_index(benchmark::State &state, tyson::SimdLevel level)
+{
+    auto raw = nested_maps(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        tyson::StructuralIndex index {raw, level};
+        benchmark::DoNotOptimize(index.positions().data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+}
+BENCHMARK_CAPTURE(BM_structural_index, scalar, tyson::SimdLevel::Scalar)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+BENCHMARK_CAPTURE(BM_structural_index, sse42, tyson::SimdLevel::SSE42)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+BENCHMARK_CAPTURE(BM_structural_index, avx2, tyson::SimdLevel::AVX2)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+
+static void BM_skip_nested_maps(benchmark::State &state, bool indexed)
+{
+    auto raw = nested_maps(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        if (indexed)
+        {
+            tyson::StructuralIndex index {raw};
+            tyson::TySonParser parser {raw, index};
+            benchmark::DoNotOptimize(parser.next());
+        }
+        else
+        {
+            tyson::TySonParser parser {raw};
+            benchmark::DoNotOptimize(parser.next());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+}
+BENCHMARK_CAPTURE(BM_skip_nested_maps, plain, false)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+BENCHMARK_CAPTURE(BM_skip_nested_maps, indexed, true)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include "../TySON.hpp"
+
+/**
+ * Build a TySON Map which is nested `depth` times, every level holds a few primitives
+ *
+ * @param depth number of nested Maps
+ * @return the raw TySON string
+ */
+static std::string deep_document(std::size_t depth)
+{
+    std::string raw;
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        raw += "m{s|num|:n|" + std::to_string(i) + "|,s|name|:s|level|,s|next|:";
+    }
+    raw += "null";
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        raw += ",}";
+    }
+    return raw;
+}
+
+/**
+ * Build a TySON Vector of `entries` flat Maps
+ *
+ * @param entries number of Maps
+ * @return the raw TySON string
+ */
+static std::string wide_document(std::size_t entries)
+{
+    std::string raw = "v[";
+    for (std::size_t i = 0; i < entries; ++i)
+    {
+        auto num = std::to_string(i);
+        raw += "m{s|id|:n|" + num + "|,s|price|:n|" + num + ".25|,s|name|:s|name_" + num + "|,s|ok|:b|true|,},";
+    }
+    raw += "]";
+    return raw;
+}
+
+static void BM_stream_deep(benchmark::State &state)
+{
+    tyson::TySonObject object {deep_document(static_cast<std::size_t>(state.range(0)))};
+    for (auto _ : state)
+    {
+        std::stringstream sstream;
+        sstream << object;
+        benchmark::DoNotOptimize(sstream.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_stream_deep)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_writer_deep(benchmark::State &state)
+{
+    tyson::TySonObject object {deep_document(static_cast<std::size_t>(state.range(0)))};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tyson::Writer::to_string(object));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_writer_deep)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_stream_wide(benchmark::State &state)
+{
+    tyson::TySonObject object {wide_document(static_cast<std::size_t>(state.range(0)))};
+    for (auto _ : state)
+    {
+        std::stringstream sstream;
+        sstream << object;
+        benchmark::DoNotOptimize(sstream.str());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_stream_wide)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_writer_wide(benchmark::State &state)
+{
+    tyson::TySonObject object {wide_document(static_cast<std::size_t>(state.range(0)))};
+    tyson::Writer writer {};
+    for (auto _ : state)
+    {
+        // the buffer is kept between the iterations like it would be between queries
+        writer.clear();
+        writer.value(object);
+        benchmark::DoNotOptimize(writer.view());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_writer_wide)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -5,30 +5,35 @@
 #ifndef ANNADB_DRIVER_CONNECTION_HPP
 #define ANNADB_DRIVER_CONNECTION_HPP
 
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iterator>
 #include <map>
-#include <regex>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <unordered_map>
 #include <valarray>
 #include <zmq.hpp>
 #include "TySON.hpp"
+#include "TySON_view.hpp"
+#include "TySON_struct.hpp"
 #include "query.hpp"
+#include "query_static.hpp"
 
 
 namespace annadb
 {
-    const std::regex pattern ("(,)\\b[\\w-]{2,}+\\b\\|");
+    /**
+     * One entry of the data|:objects map, both tokens point into the AnnaDB response
+     * exampl.: test|ea63e06f-9d1c-442f-89fd-c5041d863f5f|:s|foo|
+     */
     struct KeyVal
     {
-        KeyVal(std::string data)
-        {
-            auto separation = data.find_first_of(':');
-            auto start = data[0] == ',' ? 1 : 0;
-            auto end = data[data.size() - 1] == ',' ? 1 : 0;
-            link = data.substr(start, separation - start);
-            value = data.substr(separation + 1, data.size() - 1 - separation - end);
-        }
-
-        std::string link;
-        std::string value;
+        tyson::TySonToken link;
+        tyson::TySonToken value;
     };
 
     enum class MetaType: unsigned char
@@ -66,22 +71,74 @@ namespace annadb
 
     class Data
     {
-        std::string data_;
+    public:
+        using allocator_type = tyson::TySonObject::allocator_type;
+
+    private:
+        tyson::SharedBuffer buffer_;
+        std::string_view data_;
+        allocator_type alloc_ {};
+
+        // built on the first call of get, either the Objects or the IDs of the response
+        tyson::Lazy<std::optional<tyson::TySonCollectionObject>> collection_ {};
+
+        [[nodiscard]] std::optional<tyson::TySonCollectionObject> build_collection() const noexcept
+        {
+            if (data_.starts_with("s|data|:objects"))
+            {
+                auto start_val = data_.find_first_of('{') + 1;
+                auto end_val = data_.find_last_of('}');
+
+                auto tyson_str_data = split_data(data_.substr(start_val, end_val - start_val));
+                tyson::TySonCollectionObject object {tyson_str_data.size(), true, alloc_};
+
+                for (auto &key_val: tyson_str_data)
+                {
+                    object.add(key_val.link, key_val.value);
+                }
+                return object;
+            }
+            else if (data_.starts_with("s|data|:ids"))
+            {
+                auto start_val = data_.find_first_of('[');
+                auto end_val = data_.find_last_of(']');
+
+                auto links = data_.substr(start_val + 1, end_val - start_val - 1);
+                tyson::TySonCollectionObject object {static_cast<std::size_t>(std::ranges::count(links, ',')),
+                                                     false, alloc_};
+                tyson::TySonParser parser {links};
+                while (!parser.container_closed(']'))
+                {
+                    object.add(parser.next());
+                }
+                return object;
+            }
+            return {};
+        }
 
         /**
-         * Split the data into sections to create later TysonObjects
+         * Scan the body of `objects{...}` for its link to value entries.
+         * The entries are found in a single pass and stay ranges of the response,
+         * values containing `,` or `:` are no problem since they are delimited by `|`
          *
-         * @param str_data the raw string data inside of the AnnaDB response
-         * @return the parts of the data response
+         * @param str_data the raw string data between the brackets of `objects{...}`
+         * @return the entries of the data response
          */
-        std::vector<KeyVal> split_data(std::string_view str_data) noexcept
+        static std::vector<KeyVal> split_data(std::string_view str_data) noexcept
         {
-            auto new_data = std::regex_replace(str_data.data(), pattern, "^$&");
-            auto data = utils::split(new_data, '^');
-
             std::vector<KeyVal> parts {};
-            parts.reserve(data.size());
-            std::transform(data.begin(), data.end(), std::back_inserter(parts), [](auto &val){return KeyVal(val);});
+            tyson::TySonParser parser {str_data};
+
+            while (!parser.container_closed('}'))
+            {
+                KeyVal part {parser.next(), {}};
+                if (!parser.consume(':'))
+                {
+                    break;
+                }
+                part.value = parser.next();
+                parts.emplace_back(part);
+            }
 
             return parts;
         }
@@ -91,56 +148,154 @@ namespace annadb
         /**
          * create a new Data object from the raw string
          * @param data
+         * @param alloc used for the TySonObjects built by get
+         */
+        explicit Data(std::string_view data, const allocator_type &alloc = {}) : buffer_(tyson::SharedBuffer::copy(data)),
+                                                                                 data_(buffer_.view()), alloc_(alloc)
+        {}
+
+        /**
+         * create a new Data object which shares the buffer of the received response
+         *
+         * @param buffer the whole AnnaDB response
+         * @param data the data part inside of the buffer
+         * @param alloc used for the TySonObjects built by get
          */
-        explicit Data(std::string_view data) noexcept : data_(data) {}
+        Data(tyson::SharedBuffer buffer, std::string_view data, const allocator_type &alloc = {}) noexcept
+            : buffer_(std::move(buffer)), data_(data), alloc_(alloc)
+        {}
         ~Data() = default;
 
         /**
-         * the AnnaDB response can contains Objects or IDs which will be handled differently
+         * View the AnnaDB response without copying it,
+         * the views stay valid as long as this Data object or the Journal it comes from.
          *
          * @tparam T the TySonType Objects or IDs
-         * @return a TySonCollection which holds either the IDs or the Objects
+         * @return a MapView of links to values for Objects or a VectorView of links for IDs
          */
         template<tyson::TySonType T>
-        requires (T == tyson::TySonType::Objects || T == tyson::TySonType::IDs)
-        std::optional<tyson::TySonCollectionObject> get() noexcept
+        requires (T == tyson::TySonType::Objects)
+        [[nodiscard]] std::optional<tyson::MapView> view() const noexcept
         {
-            if (data_.starts_with(std::string("s|data|:objects")) && T == tyson::TySonType::Objects)
+            if (!data_.starts_with("s|data|:objects"))
             {
-                auto start_val = data_.find_first_of('{') + 1;
-                auto end_val = data_.find_last_of('}');
+                return {};
+            }
 
-                auto tyson_str_data = split_data(data_.substr(start_val, end_val - start_val));
-                tyson::TySonCollectionObject object {tyson_str_data.size(), true};
-                
-                for (auto &key_val: tyson_str_data)
-                {
-                    object.add(key_val.link, key_val.value);
-                }
+            auto start_val = data_.find_first_of('{') + 1;
+            auto end_val = data_.find_last_of('}');
+            return tyson::MapView {tyson::TySonToken {tyson::TySonType::Map,
+                                                      data_.substr(start_val - 1, end_val - start_val + 2),
+                                                      "m",
+                                                      data_.substr(start_val, end_val - start_val)}};
+        }
 
-                tyson_str_data.clear();
-                tyson_str_data.shrink_to_fit();
+        template<tyson::TySonType T>
+        requires (T == tyson::TySonType::IDs)
+        [[nodiscard]] std::optional<tyson::VectorView> view() const noexcept
+        {
+            if (!data_.starts_with("s|data|:ids"))
+            {
+                return {};
+            }
 
-                return object;
+            auto start_val = data_.find_first_of('[') + 1;
+            auto end_val = data_.find_last_of(']');
+            return tyson::VectorView {tyson::TySonToken {tyson::TySonType::Vector,
+                                                         data_.substr(start_val - 1, end_val - start_val + 2),
+                                                         "v",
+                                                         data_.substr(start_val, end_val - start_val)}};
+        }
+
+        /**
+         * Walk the objects or ids of the AnnaDB response once and report them to the handler,
+         * no TySonObject is built so the memory usage stays the same for any size of the response.
+         * The objects are reported as a Map with the links as keys, the ids as a Vector of links.
+         *
+         * exampl.: sum up a field of all objects
+         *      struct Sum {
+         *          bool is_num = false; long sum = 0;
+         *          void on_key(const tyson::TySonToken &key) { is_num = key.value == "num"; }
+         *          void on_number(std::string_view val) { if (is_num) sum += std::stol(std::string(val)); }
+         *      };
+         *
+         * @param handler @see tyson::TySonHandler
+         * @return false if the response holds neither objects nor ids
+         */
+        template<tyson::TySonHandler Handler>
+        bool walk(Handler &handler) const
+        {
+            if (auto objects = view<tyson::TySonType::Objects>())
+            {
+                tyson::TySonParser::walk(objects->token(), handler);
+                return true;
             }
-            else if (data_.starts_with(std::string("s|data|:ids"))  && T == tyson::TySonType::IDs)
+            if (auto ids = view<tyson::TySonType::IDs>())
             {
-                auto start_val = data_.find_first_of('[');
-                auto end_val = data_.find_last_of(']');
+                tyson::TySonParser::walk(ids->token(), handler);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Decode the objects of the response straight into structs, no TySonObject is built
+         *
+         * exampl.: std::vector<User> users = data.decode<User>("users");
+         *
+         * @tparam T a struct described by tyson::Describe
+         * @param collection only decode the objects of this collection, all objects if it is empty
+         * @return the decoded objects in the order of the response
+         * @throw invalid_argument if a value does not fit to the type of its field
+         */
+        template<tyson::Described T>
+        [[nodiscard]] std::vector<T> decode(std::string_view collection = {}) const
+        {
+            std::vector<T> objects {};
+            auto entries = view<tyson::TySonType::Objects>();
+            if (!entries)
+            {
+                return objects;
+            }
 
-                auto tyson_str_data = utils::split(data_.substr(start_val + 1, end_val - start_val - 1), ',');
-                tyson::TySonCollectionObject object {tyson_str_data.size()};
-                for (auto &link_data: tyson_str_data)
+            tyson::TySonParser parser {entries->token().value};
+            while (!parser.container_closed('}'))
+            {
+                auto link = parser.next();
+                if (!parser.consume(':'))
+                {
+                    break;
+                }
+                auto value = parser.next();
+                if (collection.empty() || link.tag == collection)
                 {
-                    object.add(link_data);
+                    tyson::decode(value, objects.emplace_back());
                 }
+            }
+            return objects;
+        }
 
-                tyson_str_data.clear();
-                tyson_str_data.shrink_to_fit();
+        /**
+         * the AnnaDB response can contains Objects or IDs which will be handled differently.
+         * The collection is built on the first call, every further call returns the same one.
+         * Concurrent calls are safe, the collection is built once.
+         *
+         * @tparam T the TySonType Objects or IDs
+         * @return a TySonCollection which holds either the IDs or the Objects
+         */
+        template<tyson::TySonType T>
+        requires (T == tyson::TySonType::Objects || T == tyson::TySonType::IDs)
+        const std::optional<tyson::TySonCollectionObject>& get() const noexcept
+        {
+            static const std::optional<tyson::TySonCollectionObject> none {};
 
-                return object;
+            constexpr std::string_view prefix = T == tyson::TySonType::Objects ? "s|data|:objects" : "s|data|:ids";
+            if (!data_.starts_with(prefix))
+            {
+                return none;
             }
-            return {};
+
+            return collection_.get([this] { return build_collection(); });
         }
     };
 
@@ -184,17 +339,19 @@ namespace annadb
             auto pos_type_start = meta_txt_.find(':');
             auto pos_type_end = meta_txt_.find('{');
             auto meta_type_str = meta_txt_.substr(pos_type_start, pos_type_end - pos_type_start);
-            metaType = metaTypes.at(meta_type_str);
+
+            auto found = metaTypes.find(meta_type_str);
+            metaType = found != metaTypes.end() ? found->second : MetaType::none;
         }
 
         friend std::ostream & operator<<(std::ostream &os, const Meta& meta) noexcept
         {
             std::string count_val = "0";
 
-            auto count = meta.data_["count"];
+            const auto *count = meta.data_.find("count");
             if (count)
             {
-                count_val = count.value().value<tyson::TySonType::String>();
+                count_val = count->value<tyson::TySonType::String>();
             }
 
             std::string repr = "{s|count|:n|" + count_val + "|";
@@ -221,20 +378,31 @@ namespace annadb
          *
          * @return the data part of the meta object
          */
-        tyson::TySonObject data() noexcept
+        [[nodiscard]] const tyson::TySonObject& data() const noexcept
         {
             return data_;
         }
     
+        /**
+         *
+         * @tparam T the integral type of the count
+         * @return the number of affected rows, empty if there is no count, it is no Number or it does not fit into T
+         */
         template<typename T>
         requires std::is_integral_v<T>
-        std::optional<T> rows() noexcept
+        std::optional<T> rows() const noexcept
         {
-            auto count = data_["count"];
+            const auto *count = data_.find("count");
             if (count)
             {
-                auto res = count.value().value<T>();
-                return res;
+                try
+                {
+                    return count->value<T>();
+                }
+                catch (const std::exception &)
+                {
+                    return {};
+                }
             }
             return {};
         }
@@ -243,7 +411,7 @@ namespace annadb
          *
          * @return the type part of the meta object
          */
-        MetaType type() noexcept
+        [[nodiscard]] MetaType type() const noexcept
         {
             return metaType;
         }
@@ -251,9 +419,38 @@ namespace annadb
 
     class Journal
     {
-        std::string data_;
-        std::string meta_;
+    public:
+        using allocator_type = tyson::TySonObject::allocator_type;
+
+    private:
+        tyson::SharedBuffer buffer_;
+        std::string_view data_;
+        std::string_view meta_;
         bool result_ = false;
+        allocator_type alloc_ {};
+
+        // built on the first access, the raw parts above point into buffer_
+        tyson::Lazy<Meta> meta_cache_ {};
+        tyson::Lazy<Data> data_cache_ {};
+
+        /**
+         * Assign one entry of the response map to the data or meta part
+         *
+         * @param entry `s|data|:<...>` or `s|meta|:<...>`
+         * @param key_size the size of the key inside of entry
+         */
+        void assign_entry(std::string_view entry, std::size_t key_size) noexcept
+        {
+            auto key = utils::trim(entry.substr(0, key_size));
+            if (key == "s|data|")
+            {
+                data_ = utils::trim(entry);
+            }
+            else if (key == "s|meta|")
+            {
+                meta_ = utils::trim(entry);
+            }
+        }
 
         /**
          * Parse the AnnaDB query response into a meta and a data object
@@ -266,25 +463,71 @@ namespace annadb
             /*
              * The response format from annadb is
              * `result:<ok|false>[response{s|data|<...>, s|meta|<...>}]`
+             * the entries of the response map are found by walking the structural chars,
+             * chars inside of TySON values like `s|a,b|` are not part of the index
              */
-            auto pos_result_end = response.find('[');
-            auto pos_data_begin = response.find("s|data|:");
-
-            // the meta information is always at the end,
-            // so that it is faster to use rfind instead of regular find
-            auto pos_meta_begin = response.rfind("s|meta|:");
+            std::size_t depth = 0;
+            std::size_t entry_start = 0;
+            std::size_t key_end = std::string_view::npos;
 
-            // there is no usage for the closing tags, so we exclude them
-            auto pos_response_end = response.rfind(",}]");
+            const auto visit = [&](std::size_t pos)
+            {
+                switch (response[pos])
+                {
+                    case '[':
+                    case '{':
+                        if (depth == 0 && response.substr(0, pos).find("ok") != std::string_view::npos)
+                        {
+                            result_ = true;
+                        }
+                        if (++depth == 2)
+                        {
+                            entry_start = pos + 1;
+                            key_end = std::string_view::npos;
+                        }
+                        break;
+                    case ']':
+                    case '}':
+                        if (depth == 2 && key_end != std::string_view::npos)
+                        {
+                            assign_entry(response.substr(entry_start, pos - entry_start), key_end - entry_start);
+                        }
+                        depth = depth > 0 ? depth - 1 : 0;
+                        break;
+                    case ',':
+                        if (depth == 2)
+                        {
+                            if (key_end != std::string_view::npos)
+                            {
+                                assign_entry(response.substr(entry_start, pos - entry_start), key_end - entry_start);
+                            }
+                            entry_start = pos + 1;
+                            key_end = std::string_view::npos;
+                        }
+                        break;
+                    case ':':
+                        if (depth == 2 && key_end == std::string_view::npos)
+                        {
+                            key_end = pos;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            };
 
-            auto res = response.substr(0, pos_result_end);
-            if (res.find("ok") != std::string::npos)
+            // the 32 bit offsets of the index can not hold the positions of larger responses
+            if (response.size() > tyson::StructuralIndex::max_size)
             {
-                result_ = true;
+                tyson::StructuralIndex::scan(response, visit);
+                return;
             }
 
-            data_ = response.substr(pos_data_begin, pos_meta_begin - pos_data_begin);
-            meta_ = response.substr(pos_meta_begin, pos_response_end - pos_meta_begin);
+            tyson::StructuralIndex index {response};
+            for (auto pos : index.positions())
+            {
+                visit(pos);
+            }
         }
 
         friend std::ostream & operator<<(std::ostream &os, const Journal& journal) noexcept
@@ -303,10 +546,23 @@ namespace annadb
          * Creating a new Journal object from the AnnaDB response
          *
          * @param response string
+         * @param alloc used for all TySonObjects of the data part, the memory resource must outlive the Journal
          */
-        explicit Journal(std::string_view response) noexcept
+        explicit Journal(std::string_view response, const allocator_type &alloc = {})
+            : Journal(tyson::SharedBuffer::copy(response), alloc)
+        {}
+
+        /**
+         * Creating a new Journal object which keeps the received response alive
+         * instead of copying the data and meta part out of it
+         *
+         * @param response the whole AnnaDB response
+         * @param alloc used for all TySonObjects of the data part, the memory resource must outlive the Journal
+         */
+        explicit Journal(tyson::SharedBuffer response, const allocator_type &alloc = {}) noexcept
+            : buffer_(std::move(response)), alloc_(alloc)
         {
-            parse_response(response);
+            parse_response(buffer_.view());
         }
 
         ~Journal() = default;
@@ -322,26 +578,274 @@ namespace annadb
         }
 
         /**
+         * The meta part is parsed on the first call only, concurrent calls are safe
          *
          * @return the meta part of the AnnaDB query response
          */
-        [[nodiscard]] Meta meta() const noexcept
+        [[nodiscard]] const Meta& meta() const noexcept
         {
-            Meta meta{meta_};
-            return meta;
+            return meta_cache_.get([this] { return Meta {meta_}; });
         }
 
         /**
+         * The data part is created on the first call only and shares the buffer of the response,
+         * concurrent calls are safe
          *
          * @return the data part of the AnnaDB query response
          */
-        [[nodiscard]] Data data() const noexcept
+        [[nodiscard]] const Data& data() const noexcept
         {
-            Data data{data_};
-            return data;
+            return data_cache_.get([this] { return Data {buffer_, data_, alloc_}; });
         }
     };
 
+    /**
+     * Limits of the chunks a bulk insert is split into
+     */
+    struct BulkInsertOptions
+    {
+        // records of the first chunk, the following chunks grow or shrink with the observed latency
+        std::size_t initial_records = 1024;
+        std::size_t min_records = 16;
+        std::size_t max_records = 65536;
+        // a chunk ends after the record which reaches this size
+        std::size_t max_bytes = 4 * 1024 * 1024;
+        // a chunk which takes longer than this is halved, one faster than half of it is doubled
+        std::chrono::milliseconds target_latency {50};
+    };
+
+    /**
+     * The ids of all inserted records and the throughput of a bulk insert
+     */
+    struct BulkInsertResult
+    {
+        // in the order of the inserted records
+        std::vector<tyson::Uuid> ids {};
+        // ids of inserted records which are no uuid, they are never created by AnnaDB itself and not part of ids
+        std::size_t other_ids = 0;
+        // false if a chunk could not be sent or AnnaDB refused it, the following chunks were not sent
+        bool ok = true;
+        // records of the chunk which failed after it was sent, AnnaDB refused them or may have inserted them
+        // if only the response was lost
+        std::size_t unconfirmed = 0;
+        // the insert query of the records which were read from the range but never sent, it can be sent with AnnaDB::send,
+        // the records which were not read yet are left in the range
+        std::string unsent {};
+        std::size_t unsent_records = 0;
+        std::size_t records = 0;
+        std::size_t chunks = 0;
+        std::size_t bytes = 0;
+        std::chrono::nanoseconds elapsed {};
+
+        [[nodiscard]] double records_per_second() const noexcept
+        {
+            return elapsed.count() ? static_cast<double>(records) * 1e9 / static_cast<double>(elapsed.count()) : 0;
+        }
+
+        [[nodiscard]] double bytes_per_second() const noexcept
+        {
+            return elapsed.count() ? static_cast<double>(bytes) * 1e9 / static_cast<double>(elapsed.count()) : 0;
+        }
+    };
+
+    /**
+     * The number of records of the next bulk insert chunk, adjusted by the latency of the sent ones
+     */
+    class ChunkSizer
+    {
+        BulkInsertOptions options_;
+        std::size_t records_;
+
+    public:
+        /**
+         *
+         * @param options @see connection.annadb::BulkInsertOptions
+         * @throw invalid_argument if the limits contradict each other
+         */
+        explicit ChunkSizer(const BulkInsertOptions &options) : options_(options),
+                                                                records_(options.initial_records)
+        {
+            if (options.min_records == 0 || options.min_records > options.max_records)
+            {
+                throw std::invalid_argument("min_records must be between 1 and max_records");
+            }
+            if (options.max_bytes == 0)
+            {
+                throw std::invalid_argument("max_bytes must be larger than 0");
+            }
+            records_ = std::clamp(records_, options.min_records, options.max_records);
+        }
+
+        [[nodiscard]] std::size_t records() const noexcept
+        {
+            return records_;
+        }
+
+        [[nodiscard]] std::size_t max_bytes() const noexcept
+        {
+            return options_.max_bytes;
+        }
+
+        /**
+         * Report how long AnnaDB took for a chunk from sending it until its response was received
+         *
+         * @param latency the time from sending the chunk until its response
+         * @param at_most true if the response was only read after latency, AnnaDB may have been faster, so it is not shrunk
+         */
+        void observe(std::chrono::nanoseconds latency, bool at_most = false) noexcept
+        {
+            if (latency > options_.target_latency)
+            {
+                if (!at_most)
+                {
+                    records_ = std::max(records_ / 2, options_.min_records);
+                }
+            }
+            else if (latency < options_.target_latency / 2)
+            {
+                records_ = std::min(records_ * 2, options_.max_records);
+            }
+        }
+    };
+
+    /**
+     * Write the next insert query of a bulk insert, the records are encoded straight into the writer
+     *
+     * exampl.: collection|users|:insert[m{s|name|:s|jondoe|,},];
+     *
+     * @param writer the query is appended to it
+     * @param collection the name of the collection
+     * @param first the next record, moved behind the last written one
+     * @param last end of the records
+     * @param max_records the maximum number of records of the chunk
+     * @param max_bytes the chunk ends after the record which reaches this size
+     * @return the number of written records, no query is written if it is 0
+     */
+    template<std::input_iterator It, std::sentinel_for<It> End>
+    std::size_t write_insert_chunk(tyson::Writer &writer, std::string_view collection,
+                                   It &first, const End &last,
+                                   std::size_t max_records, std::size_t max_bytes)
+    {
+        if (first == last || max_records == 0)
+        {
+            return 0;
+        }
+
+        auto start = writer.size();
+        writer.raw("collection|").raw(collection).raw("|:insert[");
+
+        std::size_t records = 0;
+        while (first != last && records < max_records && writer.size() - start < max_bytes)
+        {
+            tyson::encode(*first, writer);
+            writer.separator();
+            ++first;
+            ++records;
+        }
+
+        writer.raw("];");
+        return records;
+    }
+
+    /**
+     * Limits of the sub requests a large get is split into
+     */
+    struct GetOptions
+    {
+        // links per sub request
+        std::size_t max_links = 10000;
+        // sub requests which are in flight at the same time, each one uses its own connection
+        std::size_t connections = 4;
+    };
+
+    /**
+     * Write the get query of one sub request
+     *
+     * exampl.: collection|test|:get[test|ea63e06f-9d1c-442f-89fd-c5041d863f5f|,];
+     *
+     * @param writer the query is appended to it
+     * @param collection the name of the collection
+     * @param links must be TySonType::Link's
+     */
+    inline void write_get_chunk(tyson::Writer &writer, std::string_view collection,
+                                std::span<const tyson::TySonObject> links)
+    {
+        writer.raw("collection|").raw(collection).raw("|:get[");
+        for (const auto &link : links)
+        {
+            writer.value(link).separator();
+        }
+        writer.raw("];");
+    }
+
+    /**
+     * Merge the responses of the sub requests of a get into one collection,
+     * the objects are added in the order of the requested links
+     *
+     * @param links all requested links
+     * @param responses one response per sub request of max_links links, in the order of the sub requests
+     * @param max_links the links per sub request
+     * @param alloc used for the merged collection and all of its TySonObjects
+     * @return the found objects, links which were not found are skipped
+     */
+    inline tyson::TySonCollectionObject merge_get_responses(std::span<const tyson::TySonObject> links,
+                                                            std::span<const Journal> responses,
+                                                            std::size_t max_links,
+                                                            const Journal::allocator_type &alloc = {})
+    {
+        tyson::TySonCollectionObject merged {links.size(), true, alloc};
+
+        std::vector<KeyVal> entries {};
+        std::unordered_map<tyson::Uuid, std::size_t> ids {};
+        for (std::size_t chunk = 0; chunk < responses.size(); ++chunk)
+        {
+            // the entries of a response may come in any order, they are looked up by the uuid of their link
+            entries.clear();
+            ids.clear();
+            if (auto objects = responses[chunk].data().view<tyson::TySonType::Objects>())
+            {
+                for (const auto &[link, value] : *objects)
+                {
+                    if (auto uuid = tyson::Uuid::parse(link.token().value))
+                    {
+                        ids.try_emplace(*uuid, entries.size());
+                    }
+                    entries.push_back({link.token(), value.token()});
+                }
+            }
+
+            auto first = std::min(chunk * max_links, links.size());
+            for (const auto &link : links.subspan(first, std::min(max_links, links.size() - first)))
+            {
+                const KeyVal *found = nullptr;
+                if (auto uuid = link.link_uuid())
+                {
+                    auto pos = ids.find(*uuid);
+                    if (pos != ids.end() && entries[pos->second].link.tag == link.link_collection())
+                    {
+                        found = &entries[pos->second];
+                    }
+                }
+                else
+                {
+                    // ids which are no uuid are never created by AnnaDB itself, they are searched one by one
+                    auto raw = tyson::Writer::to_string(link);
+                    auto pos = std::ranges::find_if(entries, [&raw](const KeyVal &entry)
+                                                    {
+                                                        return entry.link.raw == raw;
+                                                    });
+                    found = pos != entries.end() ? &*pos : nullptr;
+                }
+
+                if (found)
+                {
+                    merged.add(found->link, found->value);
+                }
+            }
+        }
+        return merged;
+    }
+
     class AnnaDB
     {
         std::string username_;
@@ -351,31 +855,108 @@ namespace annadb
     
         zmq::context_t context {1};
         zmq::socket_t requester {context, ZMQ_REQ};
+        // additional connections for requests which are split into concurrent sub requests
+        std::vector<zmq::socket_t> pool_ {};
+
+        [[nodiscard]] std::string endpoint() const
+        {
+            return "tcp://" + host_ + ":" + port_;
+        }
+
+        static void free_query(void *, void *hint) noexcept
+        {
+            delete static_cast<std::string *>(hint);
+        }
 
         bool zmq_send(std::string_view query) noexcept
         {
-            zmq::message_t message(query.size());
-            std::memcpy(message.data(), query.data(), query.size());
+            try
+            {
+                zmq::message_t message(query.size());
+                std::memcpy(message.data(), query.data(), query.size());
+                return zmq_send(message);
+            }
+            catch (...)
+            {
+                // the message could not be created, nothing was sent
+                return false;
+            }
+        }
 
-            auto response = requester.send(message, zmq::send_flags::none);
+        bool zmq_send(tyson::Writer &&query) noexcept
+        {
+            return zmq_send(requester, std::move(query));
+        }
 
-            if (response)
+        bool zmq_send(zmq::message_t &message) noexcept
+        {
+            return zmq_send(requester, message);
+        }
+
+        static bool zmq_send(zmq::socket_t &socket, tyson::Writer &&query) noexcept
+        {
+            try
             {
-                return true;
+                auto message = AnnaDB::message(std::move(query));
+                return zmq_send(socket, message);
+            }
+            catch (...)
+            {
+                // the message could not be created, nothing was sent
+                return false;
+            }
+        }
+
+        static bool zmq_send(zmq::socket_t &socket, zmq::message_t &message) noexcept
+        {
+            try
+            {
+                auto response = socket.send(message, zmq::send_flags::none);
+
+                if (response)
+                {
+                    return true;
+                }
+            }
+            catch (...)
+            {
+                // zmq::error_t of a closed socket or context
             }
 
             return false;
         }
 
-        std::optional<std::string> zmq_receive() noexcept
+        std::optional<tyson::SharedBuffer> zmq_receive() noexcept
+        {
+            auto response = zmq_receive(requester);
+            if (!response)
+            {
+                reconnect(requester);
+            }
+            return response;
+        }
+
+        /**
+         * Replace a REQ socket whose receive failed, it would refuse every request while it waits for the reply
+         */
+        void reconnect(zmq::socket_t &socket) noexcept
+        {
+            socket.close();
+            socket = zmq::socket_t {context, ZMQ_REQ};
+            socket.connect(endpoint());
+        }
+
+        static std::optional<tyson::SharedBuffer> zmq_receive(zmq::socket_t &socket,
+                                                              zmq::recv_flags flags = zmq::recv_flags::none) noexcept
         {
-            zmq::message_t message;
-            auto response = requester.recv(message, zmq::recv_flags::none);
+            auto message = std::make_shared<zmq::message_t>();
+            auto response = socket.recv(*message, flags);
 
             if (response)
             {
-                auto result = std::string(static_cast<char *>(message.data()), message.size());
-                return result;
+                // the message itself becomes the buffer, so the response is never copied
+                std::string_view data {static_cast<const char *>(message->data()), message->size()};
+                return tyson::SharedBuffer {std::move(message), data};
             }
 
             return {};
@@ -404,12 +985,29 @@ namespace annadb
 
         ~AnnaDB() = default;
 
+        /**
+         * Create the message a written query is sent as.
+         * The message takes over the written buffer and zmq frees it once it is sent,
+         * so a query is never copied again after it was written.
+         *
+         * @param query @see TySON.tyson::Writer
+         * @return the message which holds the buffer of the writer
+         */
+        [[nodiscard]] static zmq::message_t message(tyson::Writer &&query)
+        {
+            auto buffer = std::make_unique<std::string>(query.take());
+            zmq::message_t message(buffer->data(), buffer->size(), free_query, buffer.get());
+            // the message owns the buffer from now on
+            static_cast<void>(buffer.release());
+            return message;
+        }
+
         /**
          * open a connection with the AnnaDB
          */
         void connect() noexcept
         {
-            requester.connect("tcp://" + host_ + ":" + port_);
+            requester.connect(endpoint());
         }
 
         /**
@@ -417,6 +1015,11 @@ namespace annadb
          */
         void close() noexcept
         {
+            for (auto &socket : pool_)
+            {
+                socket.close();
+            }
+            pool_.clear();
             requester.close();
         }
 
@@ -424,9 +1027,11 @@ namespace annadb
          * Send a TySON formatted query to AnnaDB
          *
          * @param query string in TySON format
+         * @param alloc used for the TySonObjects of the result, e.g. a std::pmr::monotonic_buffer_resource per request
          * @return a Journal object representing the result of the query if successful
          */
-        [[nodiscard]] std::optional<Journal> send(std::string_view query) noexcept
+        [[nodiscard]] std::optional<Journal> send(std::string_view query,
+                                                  const Journal::allocator_type &alloc = {}) noexcept
         {
             auto result = zmq_send(query);
 
@@ -435,36 +1040,301 @@ namespace annadb
                 auto response = zmq_receive();
                 if (response)
                 {
-                    return Journal(*response);
+                    return Journal(std::move(*response), alloc);
                 }
             }
             return {};
         }
 
         /**
-         * Send a TySON formatted query to AnnaDB
+         * Send a query which was already written, e.g. a bound prepared query
          *
-         * @param query @see query.annadb::Query::Query
+         * exampl.: db.send(prepared.bind(42, 10))
+         *
+         * @param query @see query.annadb::Query::PreparedQuery::bind
+         * @param alloc used for the TySonObjects of the result, e.g. a std::pmr::monotonic_buffer_resource per request
          * @return a Journal object representing the result of the query if successful
          */
-        [[nodiscard]] std::optional<Journal> send(annadb::Query::Query &query) noexcept
+        [[nodiscard]] std::optional<Journal> send(tyson::Writer &&query,
+                                                  const Journal::allocator_type &alloc = {}) noexcept
         {
-            std::stringstream sstream;
-            sstream << query;
-            
-            auto query_str = sstream.str();
-            auto result = zmq_send(query_str);
+            auto result = zmq_send(std::move(query));
 
             if (result)
             {
                 auto response = zmq_receive();
                 if (response)
                 {
-                    return Journal(*response);
+                    return Journal(std::move(*response), alloc);
                 }
             }
             return {};
         }
+
+        /**
+         * Send a TySON formatted query to AnnaDB
+         *
+         * @param query @see query.annadb::Query::Query
+         * @param alloc used for the TySonObjects of the result, e.g. a std::pmr::monotonic_buffer_resource per request
+         * @return a Journal object representing the result of the query if successful
+         * @throw invalid_argument if the query holds a Param, use prepare for it
+         */
+        [[nodiscard]] std::optional<Journal> send(annadb::Query::Query &query,
+                                                  const Journal::allocator_type &alloc = {})
+        {
+            tyson::Writer writer {};
+            query.write(writer);
+
+            return send(std::move(writer), alloc);
+        }
+
+        /**
+         * Send a TySON formatted query to AnnaDB, the query is used up.
+         * The records of Query::insert are sent from the buffer they were encoded into without copying them.
+         *
+         * exampl.: db.send(std::move(query))
+         *
+         * @param query @see query.annadb::Query::Query::write
+         * @param alloc used for the TySonObjects of the result, e.g. a std::pmr::monotonic_buffer_resource per request
+         * @return a Journal object representing the result of the query if successful
+         * @throw invalid_argument if the query holds a Param, use prepare for it
+         */
+        [[nodiscard]] std::optional<Journal> send(annadb::Query::Query &&query,
+                                                  const Journal::allocator_type &alloc = {})
+        {
+            return send(std::move(query).write(), alloc);
+        }
+
+        /**
+         * Insert any number of records split into chunks which are sent one after another.
+         * The next chunk is serialized while the previous one is in flight and the number of records
+         * per chunk follows the latency of the previous chunks.
+         *
+         * exampl.:
+         *      std::vector<User> users = load_users();
+         *      auto result = db.bulk_insert("users", users);
+         *      std::cout << result.ids.size() << " users, " << result.records_per_second() << " records/s";
+         *
+         * @param collection the name of the collection
+         * @param records any input range of TySonObjects or structs described by tyson::Describe
+         * @param options @see connection.annadb::BulkInsertOptions
+         * @return the ids of the inserted records and the throughput, the records which were not inserted if a chunk failed
+         * @throw invalid_argument if the options contradict each other, exceptions of the range and encoders are passed on
+         */
+        template<std::ranges::input_range R>
+        BulkInsertResult bulk_insert(std::string_view collection, R &&records, const BulkInsertOptions &options = {})
+        {
+            using clock = std::chrono::steady_clock;
+
+            ChunkSizer sizer {options};
+            BulkInsertResult result {};
+            auto first = std::ranges::begin(records);
+            auto last = std::ranges::end(records);
+            auto started = clock::now();
+
+            tyson::Writer chunk {};
+            auto chunk_records = write_insert_chunk(chunk, collection, first, last, sizer.records(), sizer.max_bytes());
+
+            while (chunk_records)
+            {
+                auto chunk_bytes = chunk.size();
+                auto message = AnnaDB::message(std::move(chunk));
+                if (!zmq_send(message))
+                {
+                    result.ok = false;
+                    result.unsent = message.to_string();
+                    result.unsent_records = chunk_records;
+                    break;
+                }
+                auto sent = clock::now();
+
+                // REQ/REP allows one request in flight, the time AnnaDB needs for it is used to serialize the next one,
+                // its size follows the chunks whose responses were received before
+                tyson::Writer next {std::min(chunk_bytes, sizer.max_bytes()) + collection.size() + 64};
+                std::size_t next_records = 0;
+                try
+                {
+                    next_records = write_insert_chunk(next, collection, first, last,
+                                                      sizer.records(), sizer.max_bytes());
+                }
+                catch (...)
+                {
+                    // the REQ socket only accepts the next request after the response of the one in flight
+                    static_cast<void>(zmq_receive());
+                    throw;
+                }
+                auto encoded = clock::now();
+                const auto stop = [&]
+                {
+                    result.ok = false;
+                    result.unconfirmed = chunk_records;
+                    result.unsent = next.take();
+                    result.unsent_records = next_records;
+                };
+
+                // a response which is already there arrived while the next chunk was encoded, then AnnaDB
+                // took at most the encoding time and a slow encoding must not shrink the chunks
+                auto response = zmq_receive(requester, zmq::recv_flags::dontwait);
+                if (response)
+                {
+                    sizer.observe(encoded - sent, true);
+                }
+                else
+                {
+                    response = zmq_receive();
+                    sizer.observe(clock::now() - sent);
+                }
+                if (!response)
+                {
+                    stop();
+                    break;
+                }
+
+                Journal journal {std::move(*response)};
+                auto ids = journal.data().view<tyson::TySonType::IDs>();
+                if (!journal.ok() || !ids)
+                {
+                    stop();
+                    break;
+                }
+                // the chunk is inserted, an id which is no uuid is counted instead of failing the whole insert
+                for (const auto &id : *ids)
+                {
+                    if (auto uuid = tyson::Uuid::parse(id.token().value))
+                    {
+                        result.ids.push_back(*uuid);
+                    }
+                    else
+                    {
+                        ++result.other_ids;
+                    }
+                }
+
+                result.records += chunk_records;
+                result.bytes += chunk_bytes;
+                ++result.chunks;
+
+                chunk = std::move(next);
+                chunk_records = next_records;
+            }
+
+            result.elapsed = clock::now() - started;
+            return result;
+        }
+
+        /**
+         * Get the objects of any number of links. Large lists are split into sub requests of
+         * max_links links which are sent concurrently over additional connections,
+         * the connections are opened on the first call and kept until close.
+         *
+         * exampl.:
+         *      auto objects = db.get("users", links, {.max_links = 5000, .connections = 8});
+         *      auto user = objects->get<tyson::TySonType::Object>("users", uuid);
+         *
+         * @param collection the name of the collection
+         * @param links must be TySonType::Link's
+         * @param options @see connection.annadb::GetOptions
+         * @param alloc used for the TySonObjects of the result
+         * @return the found objects in the order of the links, empty if a sub request failed
+         * @throw invalid_argument if not all links are TySonType::Link's or the options are 0
+         */
+        [[nodiscard]] std::optional<tyson::TySonCollectionObject> get(std::string_view collection,
+                                                                      std::span<const tyson::TySonObject> links,
+                                                                      const GetOptions &options = {},
+                                                                      const Journal::allocator_type &alloc = {})
+        {
+            if (options.max_links == 0 || options.connections == 0)
+            {
+                throw std::invalid_argument("max_links and connections must be larger than 0");
+            }
+            if (!std::ranges::all_of(links, [](const auto &link) { return link.type() == tyson::TySonType::Link; }))
+            {
+                throw std::invalid_argument(".get can only be used with a TySonObject of TySonType::Link.");
+            }
+
+            if (links.empty())
+            {
+                return tyson::TySonCollectionObject {0, true, alloc};
+            }
+
+            auto chunks = (links.size() + options.max_links - 1) / options.max_links;
+            auto workers = std::min(options.connections, chunks);
+            while (pool_.size() + 1 < workers)
+            {
+                pool_.emplace_back(context, ZMQ_REQ).connect(endpoint());
+            }
+
+            std::vector<std::optional<tyson::SharedBuffer>> responses(chunks);
+            std::vector<std::exception_ptr> errors(workers);
+            std::atomic<std::size_t> next_chunk {0};
+            std::atomic<bool> failed {false};
+
+            // every worker owns one connection and takes the next sub request until none is left
+            const auto work = [&](zmq::socket_t &socket, std::size_t worker)
+            {
+                try
+                {
+                    for (auto chunk = next_chunk++; chunk < chunks && !failed; chunk = next_chunk++)
+                    {
+                        auto first = std::min(chunk * options.max_links, links.size());
+                        tyson::Writer writer {};
+                        write_get_chunk(writer, collection,
+                                        links.subspan(first, std::min(options.max_links, links.size() - first)));
+
+                        if (zmq_send(socket, std::move(writer)))
+                        {
+                            responses[chunk] = zmq_receive(socket);
+                            if (!responses[chunk])
+                            {
+                                reconnect(socket);
+                            }
+                        }
+                        if (!responses[chunk])
+                        {
+                            failed = true;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    errors[worker] = std::current_exception();
+                    failed = true;
+                }
+            };
+
+            {
+                std::vector<std::jthread> threads {};
+                threads.reserve(workers - 1);
+                for (std::size_t worker = 1; worker < workers; ++worker)
+                {
+                    threads.emplace_back(work, std::ref(pool_[worker - 1]), worker);
+                }
+                work(requester, 0);
+            }
+
+            for (const auto &error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+            if (failed)
+            {
+                return {};
+            }
+
+            std::vector<Journal> journals {};
+            journals.reserve(chunks);
+            for (auto &response : responses)
+            {
+                if (!journals.emplace_back(std::move(*response)).ok())
+                {
+                    return {};
+                }
+            }
+            return merge_get_responses(links, journals, options.max_links, alloc);
+        }
     };
 }
 
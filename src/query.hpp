@@ -7,9 +7,14 @@
 
 #include <string>
 #include <cstdarg>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <utility>
 #include "TySON.hpp"
+#include "TySON_struct.hpp"
 #include "query_comparision.hpp"
+#include "query_pipeline.hpp"
 
 namespace annadb::Query
 {
@@ -29,7 +34,14 @@ namespace annadb::Query
     struct SortCmd
     {
         virtual ~SortCmd() = default;
-        virtual std::string data() const = 0;
+        virtual void write(tyson::Writer &writer) const = 0;
+
+        [[nodiscard]] std::string data() const
+        {
+            tyson::Writer writer {};
+            write(writer);
+            return writer.take();
+        }
     };
 
     class Asc : public SortCmd
@@ -45,9 +57,9 @@ namespace annadb::Query
          */
         explicit Asc(std::string_view field) noexcept : field_(field) {}
 
-        [[nodiscard]] std::string data() const override
+        void write(tyson::Writer &writer) const override
         {
-            return "asc(value|" + field_ + "|)";
+            writer.raw("asc(value|").raw(field_).raw("|)");
         }
     };
 
@@ -64,9 +76,9 @@ namespace annadb::Query
          */
         explicit Desc(std::string_view field) noexcept : field_(field) {}
 
-        [[nodiscard]] std::string data() const override
+        void write(tyson::Writer &writer) const override
         {
-            return "desc(value|" + field_ + "|)";
+            writer.raw("desc(value|").raw(field_).raw("|)");
         }
     };
 
@@ -74,79 +86,137 @@ namespace annadb::Query
 
     class QueryCmd
     {
-        std::string name_;
-        bool start_cmd_ = false;
-        [[nodiscard]] virtual std::string annadb_query() = 0;
-        [[nodiscard]] virtual std::vector<std::string> previous_steps_() = 0;
-        [[nodiscard]] virtual std::vector<std::string> next_steps_() = 0;
+        Step step_;
+        virtual void annadb_query(tyson::Writer &writer) = 0;
 
     public:
-        QueryCmd() = default;
-        explicit QueryCmd(std::string_view name, bool start_cmd) : name_(name), start_cmd_(start_cmd) {}
+        explicit QueryCmd(Step step) noexcept : step_(step) {}
         virtual ~QueryCmd() = default;
 
-        [[nodiscard]] std::string name() noexcept
+        [[nodiscard]] Step step() const noexcept
+        {
+            return step_;
+        }
+
+        [[nodiscard]] std::string_view name() const noexcept
         {
-            return this->name_;
+            return step_name(step_);
         }
 
         [[nodiscard]] bool can_start_pipeline() const noexcept
         {
-            return start_cmd_;
+            return step_allowed(Step::None, step_);
         }
 
         [[nodiscard]] virtual std::string query() noexcept
         {
-            return this->annadb_query();
+            tyson::Writer writer {};
+            this->annadb_query(writer);
+            return writer.take();
         }
 
-        [[nodiscard]] bool next_step_allowed(const std::string &cmdName) noexcept
+        /**
+         * The chars the statement is known to write before it is written, e.g. already encoded records
+         *
+         * @return 0 if nothing is known upfront
+         */
+        [[nodiscard]] virtual std::size_t known_size() const noexcept
         {
-            if (next_steps_().empty())
-            {
-                return false;
-            }
+            return 0;
+        }
 
-            auto res = std::find(next_steps_().begin(), next_steps_().end(), cmdName);
-            return res != next_steps_().end();
+        /**
+         * Append the statement to the query which is written
+         *
+         * @param writer exampl.: find[gt{root: n|5|},]
+         */
+        void write(tyson::Writer &writer)
+        {
+            this->annadb_query(writer);
         }
 
-        [[nodiscard]] bool previous_step_allowed(const std::string &cmdName) noexcept
+        [[nodiscard]] bool next_step_allowed(Step next) const noexcept
         {
-            if (previous_steps_().empty())
-            {
-                return false;
-            }
+            return contains(next_steps(step_), next);
+        }
 
-            auto res = std::find(previous_steps_().begin(), previous_steps_().end(), cmdName);
-            return res != next_steps_().end();
+        [[nodiscard]] bool previous_step_allowed(Step previous) const noexcept
+        {
+            return contains(previous_steps(step_), previous);
         }
     };
 
 
+    /**
+     * A record which can be inserted without building a TySonObject first
+     */
+    template<typename T>
+    concept InsertRecord = std::same_as<T, tyson::TySonObject> || tyson::Described<T>;
+
     class Insert : public QueryCmd
     {
         std::vector<tyson::TySonObject> values_;
+        // records which were already encoded, each one is followed by a `,`,
+        // the first head_ chars are the beginning of the query, exampl.: collection|users|:insert[
+        tyson::Writer encoded_;
+        std::size_t head_ = 0;
 
-        std::string annadb_query() override
+        void annadb_query(tyson::Writer &writer) override
         {
-            std::stringstream sstream;
-            sstream << "insert[";
+            writer.raw("insert[");
             std::for_each(values_.begin(), values_.end(),
-                          [&sstream](auto &val){ sstream << val << ",";});
-            sstream << "]";
-            return sstream.str();
+                          [&writer](auto &val){ writer.value(val).separator(); });
+            writer.raw(encoded_.view().substr(head_)).raw(']');
         }
 
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
+        template<typename R>
+        void encode_records(std::string_view head, R &&records)
         {
-            return {};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
+            encoded_.raw(head);
+            head_ = encoded_.size();
+
+            auto first = std::ranges::begin(records);
+            auto last = std::ranges::end(records);
+            if (first == last)
+            {
+                return;
+            }
+
+            tyson::encode(*first, encoded_);
+            encoded_.separator();
+            if constexpr (std::ranges::sized_range<R>)
+            {
+                // records of one range mostly have a similar size
+                auto record = encoded_.size() - head_;
+                encoded_.reserve(head_ + record * std::ranges::size(records) + 2);
+            }
+            for (++first; first != last; ++first)
+            {
+                tyson::encode(*first, encoded_);
+                encoded_.separator();
+            }
+        }
+
+        /**
+         * Hand the encoded records over as the written query, they are not copied again
+         *
+         * @param head the beginning of the query the records must follow, exampl.: collection|users|:insert[
+         * @return empty if the statement can only be written by copying it
+         */
+        [[nodiscard]] std::optional<tyson::Writer> take_query(std::string_view head)
         {
-            return {};
+            if (!values_.empty() || head_ == 0 || encoded_.view().substr(0, head_) != head)
+            {
+                return {};
+            }
+
+            encoded_.raw("];");
+            head_ = 0;
+            return std::exchange(encoded_, {});
         }
 
+        friend class Query;
+
     public:
         
         /**
@@ -155,13 +225,13 @@ namespace annadb::Query
          * @param obj the TySonObject you want to insert into your DB collection
          * @see TySON::tyson::TySonObject
          */
-        explicit Insert(tyson::TySonObject &obj) noexcept : QueryCmd("insert", true)
+        explicit Insert(tyson::TySonObject &obj) noexcept : QueryCmd(Step::Insert)
         {
             values_.emplace_back(std::move(obj));
         }
     
         template<typename ...T>
-        explicit Insert(T&& ...values) noexcept : QueryCmd("insert", true)
+        explicit Insert(T&& ...values) noexcept : QueryCmd(Step::Insert)
         {
             std::vector<tyson::TySonObject> objs {};
             objs.reserve(sizeof...(values));
@@ -176,8 +246,29 @@ namespace annadb::Query
          * @param objs the vector of TySonObjects you want to insert into your DB collection
          * @see TySON::tyson::TySonObject
          */
-        explicit Insert(std::vector<tyson::TySonObject> &objs) noexcept : QueryCmd("insert", true), values_(std::move(objs)) {}
+        explicit Insert(std::vector<tyson::TySonObject> &objs) noexcept : QueryCmd(Step::Insert), values_(std::move(objs)) {}
 
+        /**
+         * Create a new insert statement from any input range, exampl.: a std::vector<User>, a view or a generator.
+         * Every record is encoded while the range is read, neither the range nor TySonObjects
+         * of structs are kept, so only the written records are held in memory.
+         * The records are copied once more when the query is written, Query::insert instead encodes
+         * them behind the beginning of the query, so they are sent from that one buffer.
+         *
+         * @param records TySonObjects or structs described by tyson::Describe
+         * @see TySON_struct::tyson::Describe
+         */
+        template<std::ranges::input_range R>
+        requires InsertRecord<std::ranges::range_value_t<R>>
+        explicit Insert(R &&records) : QueryCmd(Step::Insert)
+        {
+            encode_records({}, std::forward<R>(records));
+        }
+
+        [[nodiscard]] std::size_t known_size() const noexcept override
+        {
+            return encoded_.size() - head_;
+        }
     };
 
 
@@ -185,23 +276,12 @@ namespace annadb::Query
     {
         std::vector<tyson::TySonObject> values_;
 
-        std::string annadb_query() override
+        void annadb_query(tyson::Writer &writer) override
         {
-            std::stringstream sstream;
-            sstream << "get[";
+            writer.raw("get[");
             std::for_each(values_.begin(), values_.end(),
-                          [&sstream](auto &val){ sstream << val << ",";});
-            sstream << "]";
-            return sstream.str();
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {"find", "get", "sort", "limit", "offset", "update", "delete"};
+                          [&writer](auto &val){ writer.value(val).separator(); });
+            writer.raw(']');
         }
 
     public:
@@ -214,7 +294,7 @@ namespace annadb::Query
          *
          * @throw invalid_argument if obj is not TySonType::Link
          */
-        Get(tyson::TySonObject &obj) : QueryCmd("get", true)
+        Get(tyson::TySonObject &obj) : QueryCmd(Step::Get)
         {
             if (obj.type() != tyson::TySonType::Link)
             {
@@ -232,7 +312,7 @@ namespace annadb::Query
          *
          * @throw invalid_argument if not all objs are TySonType::Link's
          */
-        Get(std::vector<tyson::TySonObject> &objs) : QueryCmd("get", true)
+        Get(std::vector<tyson::TySonObject> &objs) : QueryCmd(Step::Get)
         {
             auto all_Links = std::all_of(objs.cbegin(), objs.cend(), [](const tyson::TySonObject val)
             {
@@ -248,7 +328,7 @@ namespace annadb::Query
         }
     
         template<typename ...T>
-        explicit Get(T &&...values) : QueryCmd("get", true)
+        explicit Get(T &&...values) : QueryCmd(Step::Get)
         {
             std::vector<tyson::TySonObject> objs {};
             objs.reserve(sizeof...(values));
@@ -271,41 +351,40 @@ namespace annadb::Query
 
     class Find : public QueryCmd
     {
-        std::vector<std::unique_ptr<Comparison>> comparators_;
-        std::string annadb_query() override
-        {
-            std::stringstream sstream;
-            sstream << "find[";
-            for (auto &val : comparators_)
-            {
-                sstream << val->str() << ",";
-            }
-            sstream << "]";
-            return sstream.str();
-        }
+        // all comparisons of the statement share one pool
+        Filter filter_;
 
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
+        void annadb_query(tyson::Writer &writer) override
         {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {"find", "get", "sort", "limit", "offset", "update", "delete"};
+            writer.raw("find[");
+            filter_.write(writer);
+            writer.raw(']');
         }
 
     public:
-        Find() noexcept : QueryCmd("find", true) {};
+        Find() noexcept : QueryCmd(Step::Find) {};
         Find(Find &&rhs) = default;
 
+        /**
+         * Reserve the pool of the statement for a number of comparisons
+         *
+         * @return the Find class to add additional filter
+         */
+        Find& reserve(std::size_t comparisons)
+        {
+            filter_.reserve(comparisons);
+            return *this;
+        }
+
         Find& eq(tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Eq>(value));
+            filter_.compare(ComparisonType::EQ, "root", value);
             return *this;
         }
     
         Find& eq(std::string_view path_to_field, tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Eq>(path_to_field, value));
+            filter_.compare(ComparisonType::EQ, path_to_field, value);
             return *this;
         }
 
@@ -324,13 +403,13 @@ namespace annadb::Query
         
         Find& neq(tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Neq>(value));
+            filter_.compare(ComparisonType::NEQ, "root", value);
             return *this;
         }
     
         Find& neq(std::string_view path_to_field, tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Neq>(path_to_field, value));
+            filter_.compare(ComparisonType::NEQ, path_to_field, value);
             return *this;
         }
 
@@ -350,26 +429,26 @@ namespace annadb::Query
         template<std::convertible_to<tyson::TySonObject> T>
         Find& gt(T &&value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gt>(std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::GT, "root", tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
         
         Find& gt(tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gt>(value));
+            filter_.compare(ComparisonType::GT, "root", value);
             return *this;
         }
     
         template<std::convertible_to<tyson::TySonObject> T>
         Find& gt(std::string_view path_to_field, T &&value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gt>(path_to_field, std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::GT, path_to_field, tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
     
         Find& gt(std::string_view path_to_field, tyson::TySonObject &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gt>(path_to_field, value));
+            filter_.compare(ComparisonType::GT, path_to_field, value);
             return *this;
         }
 
@@ -390,14 +469,14 @@ namespace annadb::Query
         template<std::convertible_to<tyson::TySonObject> T>
         Find& gte(T &&value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gte>(std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::GTE, "root", tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
     
         template<std::convertible_to<tyson::TySonObject> T>
         Find& gte(std::string_view path_to_field, T &&value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Gte>(path_to_field, std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::GTE, path_to_field, tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
 
@@ -418,14 +497,14 @@ namespace annadb::Query
         template<std::convertible_to<tyson::TySonObject> T>
         Find& lt(T value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Lt>(std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::LT, "root", tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
     
         template<std::convertible_to<tyson::TySonObject> T>
         Find& lt(std::string_view path_to_field, T value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Lt>(path_to_field, std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::LT, path_to_field, tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
 
@@ -446,14 +525,14 @@ namespace annadb::Query
         template<std::convertible_to<tyson::TySonObject> T>
         Find& lte(T value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Lte>(std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::LTE, "root", tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
     
         template<std::convertible_to<tyson::TySonObject> T>
         Find& lte(std::string_view path_to_field, T value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Lte>(path_to_field, std::forward<tyson::TySonObject>(value)));
+            filter_.compare(ComparisonType::LTE, path_to_field, tyson::TySonObject(std::forward<T>(value)));
             return *this;
         }
 
@@ -472,7 +551,7 @@ namespace annadb::Query
 
         Find& q(And &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<And>(value));
+            filter_.append(value.filter());
             return *this;
         }
 
@@ -494,7 +573,7 @@ namespace annadb::Query
 
         Find& q(Or &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Or>(value));
+            filter_.append(value.filter());
             return *this;
         }
 
@@ -515,7 +594,7 @@ namespace annadb::Query
 
         Find& q(Not &value) noexcept
         {
-            comparators_.emplace_back(std::make_unique<Not>(value));
+            filter_.append(value.filter());
             return *this;
         }
 
@@ -533,6 +612,26 @@ namespace annadb::Query
             return find;
         }
 
+        /**
+         * Add any comparison, e.g. one holding a Param of a prepared query
+         *
+         * exampl.: find.q(Eq("user_id", Param {0}))
+         *
+         * @param value @see query_comparision.annadb::Query::Comparison
+         * @return the Find class to add additional filter
+         */
+        Find& q(const Comparison &value)
+        {
+            filter_.append(value.filter());
+            return *this;
+        }
+
+        Find& q(Comparison &&value)
+        {
+            filter_.append(std::move(value).filter());
+            return *this;
+        }
+
     };
 
 
@@ -540,29 +639,19 @@ namespace annadb::Query
     {
         std::vector<std::unique_ptr<annadb::Query::SortCmd>> cmds_ {};
 
-        std::string annadb_query() override
+        void annadb_query(tyson::Writer &writer) override
         {
-            std::string query = "sort[";
-            std::for_each(cmds_.begin(), cmds_.end(), [&query](std::unique_ptr<annadb::Query::SortCmd> &val)
+            writer.raw("sort[");
+            std::for_each(cmds_.begin(), cmds_.end(), [&writer](std::unique_ptr<annadb::Query::SortCmd> &val)
             {
-                query += val->data() + ",";
+                val->write(writer);
+                writer.separator();
             });
-            query += "]";
-
-            return query;
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {"find", "get", "sort", "limit", "offset", "update", "delete"};
+            writer.raw(']');
         }
 
     public:
-        explicit Sort(std::vector<std::unique_ptr<annadb::Query::SortCmd>> &&cmds) noexcept : QueryCmd("sort", false), cmds_(std::move(cmds)) {}
+        explicit Sort(std::vector<std::unique_ptr<annadb::Query::SortCmd>> &&cmds) noexcept : QueryCmd(Step::Sort), cmds_(std::move(cmds)) {}
     
         template<std::convertible_to<std::string> ...T>
         static Sort ASC(T&& ...fields) noexcept
@@ -595,31 +684,37 @@ namespace annadb::Query
     class Limit : public QueryCmd
     {
         std::string data_;
-        std::string annadb_query() override
+        std::optional<Param> param_;
+        void annadb_query(tyson::Writer &writer) override
         {
-            return "limit(n|" + data_ + "|)";
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {"find", "get", "sort", "limit", "offset", "update", "delete"};
+            writer.raw("limit(");
+            if (param_)
+            {
+                writer.param(param_->index, tyson::TySonType::Number);
+            }
+            else
+            {
+                writer.raw("n|").raw(data_).raw('|');
+            }
+            writer.raw(')');
         }
 
     public:
-        Limit(const Limit &rhs) noexcept : QueryCmd("delete", true), data_(rhs.data_) {};
+        Limit(const Limit &rhs) noexcept : QueryCmd(Step::Limit), data_(rhs.data_), param_(rhs.param_) {};
 
-        explicit Limit(short data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(unsigned short data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(int data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(unsigned int data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(long data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(unsigned long data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(long long data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
-        explicit Limit(unsigned long long data) : QueryCmd("limit", false), data_(std::to_string(data)) {}
+        /**
+         * @param param the amount of values in the result is bound when the prepared query is sent
+         */
+        explicit Limit(Param param) noexcept : QueryCmd(Step::Limit), param_(param) {}
+
+        explicit Limit(short data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(unsigned short data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(int data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(unsigned int data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(long data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(unsigned long data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(long long data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
+        explicit Limit(unsigned long long data) : QueryCmd(Step::Limit), data_(std::to_string(data)) {}
 
     };
 
@@ -627,32 +722,38 @@ namespace annadb::Query
     class Offset : public QueryCmd
     {
         std::string data_;
+        std::optional<Param> param_;
 
-        std::string annadb_query() override
-        {
-            return "offset(n|" + data_ + "|)";
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
+        void annadb_query(tyson::Writer &writer) override
         {
-            return {"find", "get", "sort", "limit", "offset", "update", "delete"};
+            writer.raw("offset(");
+            if (param_)
+            {
+                writer.param(param_->index, tyson::TySonType::Number);
+            }
+            else
+            {
+                writer.raw("n|").raw(data_).raw('|');
+            }
+            writer.raw(')');
         }
 
     public:
-        Offset(const Offset &rhs) : QueryCmd("delete", true), data_(rhs.data_) {};
+        Offset(const Offset &rhs) : QueryCmd(Step::Offset), data_(rhs.data_), param_(rhs.param_) {};
 
-        explicit Offset(short data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(unsigned short data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(int data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(unsigned int data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(long data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(unsigned long data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(long long data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
-        explicit Offset(unsigned long long data) : QueryCmd("offset", false), data_(std::to_string(data)) {}
+        /**
+         * @param param the amount of values you skip is bound when the prepared query is sent
+         */
+        explicit Offset(Param param) noexcept : QueryCmd(Step::Offset), param_(param) {}
+
+        explicit Offset(short data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(unsigned short data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(int data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(unsigned int data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(long data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(unsigned long data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(long long data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
+        explicit Offset(unsigned long long data) : QueryCmd(Step::Offset), data_(std::to_string(data)) {}
 
     };
 
@@ -661,46 +762,23 @@ namespace annadb::Query
     {
         std::vector<std::tuple<UpdateType, tyson::TySonObject>> values_ {};
 
-        std::string annadb_query() override
+        void annadb_query(tyson::Writer &writer) override
         {
-            std::stringstream sstream;
-            sstream << "update[";
-            for (auto &val : values_)
+            writer.raw("update[");
+            for (const auto &[type, obj] : values_)
             {
-                auto type = std::get<0>(val);
-                auto obj = std::get<1>(val);
-
-                if (type == UpdateType::Set)
-                {
-                    sstream << "set{" << obj << "},";
-                }
-                else
-                {
-                    sstream << "inc{" << obj << "},";
-                }
+                writer.raw(type == UpdateType::Set ? "set{" : "inc{").value(obj).raw("},");
             }
-
-            sstream << "]";
-
-            return sstream.str();
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {};
+            writer.raw(']');
         }
 
     public:
 
-        Update(tyson::TySonObject &val, UpdateType &type) noexcept : QueryCmd("update", false)
+        Update(tyson::TySonObject &val, UpdateType &type) noexcept : QueryCmd(Step::Update)
         {
             values_.emplace_back(type, val);
         }
-        Update(std::vector<tyson::TySonObject> &values, UpdateType &type) noexcept : QueryCmd("update", false)
+        Update(std::vector<tyson::TySonObject> &values, UpdateType &type) noexcept : QueryCmd(Step::Update)
         {
             std::for_each(values.begin(), values.end(),
                           [this, &type](auto val)
@@ -708,62 +786,43 @@ namespace annadb::Query
                             this->values_.emplace_back(type, val);
                           });
         }
-        Update(std::vector<std::tuple<UpdateType, tyson::TySonObject>> &&values) noexcept : QueryCmd("update", false), values_(values) {}
+        Update(std::vector<std::tuple<UpdateType, tyson::TySonObject>> &&values) noexcept : QueryCmd(Step::Update), values_(values) {}
     };
 
 
     class Delete : public QueryCmd
     {
-        std::string annadb_query() override
-        {
-            return "delete";
-        }
-
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "find", "get", "sort", "limit", "offset"};
-        };
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
+        void annadb_query(tyson::Writer &writer) override
         {
-            return {};
+            writer.raw("delete");
         }
 
     public:
-        Delete() = default;
-        Delete(const Delete &) : QueryCmd("delete", false) {};
+        Delete() noexcept : QueryCmd(Step::Delete) {}
+        Delete(const Delete &) : QueryCmd(Step::Delete) {};
     };
     
     class Project : public QueryCmd
     {
         std::vector<std::pair<std::string, tyson::TySonObject>> values_;
     
-        std::string annadb_query() override
+        void annadb_query(tyson::Writer &writer) override
         {
-            std::stringstream sstream;
-            sstream << "project{";
+            writer.raw("project{");
             std::for_each(values_.begin(), values_.end(),
-                          [&sstream](auto &val)
+                          [&writer](auto &val)
                           {
-                            sstream << "s|" <<std::get<0>(val) << "|:" << std::get<1>(val) << ",";
+                            writer.key(std::get<0>(val)).value(std::get<1>(val)).separator();
                           });
-            sstream << "}";
-            return sstream.str();
+            writer.raw('}');
         }
         
-        [[nodiscard]] std::vector<std::string> previous_steps_() noexcept override
-        {
-            return { "get", "find", "sort", "limit", "offset"};
-        };
         
-        [[nodiscard]] std::vector<std::string> next_steps_() noexcept override
-        {
-            return {};
-        }
         
     public:
 
         template<std::convertible_to<std::pair<std::string, tyson::TySonObject>> ...T>
-        explicit Project(T && ... objs)
+        explicit Project(T && ... objs) : QueryCmd(Step::Project)
         {
             values_.reserve(sizeof...(objs));
             (values_.emplace_back(objs), ...);
@@ -771,55 +830,246 @@ namespace annadb::Query
     };
 
 
-    class Query
+    /**
+     * A query which was written once, on every call only its parameters are written into a copy of the text.
+     * It is created by Query::prepare and can not be changed afterwards.
+     *
+     * exampl.:
+     *      Find find {};
+     *      find.q(Eq("user_id", Param {0}));
+     *      Query query {"users"};
+     *      query.find(std::move(find)).limit(Param {1});
+     *      auto prepared = query.prepare();
+     *      auto journal = db.send(prepared.bind(42, 10));
+     */
+    class PreparedQuery
     {
-        std::string collection_name_;
-        std::vector<std::unique_ptr<annadb::Query::QueryCmd>> cmds_ {};
-        void add_to_cmds(std::unique_ptr<QueryCmd> queryCmd)
+        std::string text_;
+        std::vector<tyson::ParamSlot> slots_;
+        std::size_t params_ = 0;
+
+        friend class Query;
+
+        explicit PreparedQuery(tyson::Writer &writer) : slots_(writer.params().begin(), writer.params().end())
         {
-            if (cmds_.empty() && !queryCmd->can_start_pipeline())
+            for (const auto &slot : slots_)
             {
-                throw std::invalid_argument(queryCmd->name() + " can not be used to start a new query pipeline.");
+                params_ = std::max(params_, slot.index + 1);
             }
 
-            if (cmds_.empty())
+            // a value for an index which is never used would be silently dropped by bind
+            std::vector<bool> used(params_);
+            for (const auto &slot : slots_)
+            {
+                used[slot.index] = true;
+            }
+            auto missing = std::find(used.begin(), used.end(), false);
+            if (missing != used.end())
             {
-                this->cmds_.emplace_back(std::move(queryCmd));
+                throw std::invalid_argument("The Param indices must be contiguous from 0, Param " +
+                                            std::to_string(missing - used.begin()) + " is missing");
+            }
+            text_ = writer.take();
+        }
+
+        /**
+         *
+         * @return the type a bound value is written as, empty if it is only known while writing it
+         */
+        template<typename T>
+        [[nodiscard]] static std::optional<tyson::TySonType> type_of(const T &value) noexcept
+        {
+            if constexpr (tyson::Described<T>)
+            {
+                return tyson::TySonType::Map;
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                return tyson::TySonType::Bool;
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                return tyson::TySonType::Number;
+            }
+            else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+            {
+                return tyson::TySonType::String;
+            }
+            else if constexpr (std::is_same_v<T, tyson::TySonObject>)
+            {
+                return value.type();
+            }
+            else if constexpr (tyson::is_optional<T>::value)
+            {
+                return value ? type_of(*value) : tyson::TySonType::Null;
+            }
+            else if constexpr (tyson::is_vector<T>::value)
+            {
+                return tyson::TySonType::Vector;
             }
             else
             {
-                auto latest_cmd = cmds_.size() - 1;
-                if (cmds_.at(latest_cmd)->next_step_allowed(queryCmd->name()) &&
-                    queryCmd->previous_step_allowed(cmds_.at(latest_cmd)->name()))
+                return {};
+            }
+        }
+
+        template<typename T>
+        static void bind_value(const tyson::ParamSlot &slot, const T &value, tyson::Writer &writer)
+        {
+            auto type = type_of(value);
+            if (slot.type && type && *slot.type != *type)
+            {
+                std::stringstream sstream;
+                sstream << "Param " << slot.index << " expects " << tyson::TySonType_repr(*slot.type)
+                        << " but got " << tyson::TySonType_repr(*type);
+                throw std::invalid_argument(sstream.str());
+            }
+            tyson::encode(value, writer);
+        }
+
+    public:
+        /**
+         *
+         * @return the number of values bind expects
+         */
+        [[nodiscard]] std::size_t params() const noexcept
+        {
+            return params_;
+        }
+
+        /**
+         * Append the query with the values written into its parameter slots
+         *
+         * @param writer the query is appended to it
+         * @param values one value per Param, in the order of their index
+         * @throw invalid_argument if the number of values or the type of a value does not fit, the writer is left unchanged
+         */
+        template<typename ...T>
+        void write(tyson::Writer &writer, const T &...values) const
+        {
+            if (sizeof...(values) != params_)
+            {
+                throw std::invalid_argument("The prepared query expects " + std::to_string(params_) +
+                                            " values but got " + std::to_string(sizeof...(values)));
+            }
+
+            auto size = writer.size();
+            auto params = writer.params().size();
+            try
+            {
+                std::string_view text = text_;
+                std::size_t written = 0;
+                for (const auto &slot : slots_)
                 {
-                    this->cmds_.emplace_back(std::move(queryCmd));
+                    writer.raw(text.substr(written, slot.offset - written));
+                    written = slot.offset;
+
+                    std::size_t index = 0;
+                    (void) ((index++ == slot.index && (bind_value(slot, values, writer), true)) || ...);
                 }
-                else
+                writer.raw(text.substr(written));
+            }
+            catch (...)
+            {
+                writer.truncate(size, params);
+                throw;
+            }
+        }
+
+        /**
+         * Write the query with its values into a new Writer which can be sent
+         *
+         * exampl.: db.send(prepared.bind(42, 10))
+         *
+         * @param values one value per Param, in the order of their index
+         * @return the written query
+         * @throw invalid_argument if the number of values or the type of a value does not fit
+         */
+        template<typename ...T>
+        [[nodiscard]] tyson::Writer bind(const T &...values) const
+        {
+            // most bound values are short numbers or strings
+            constexpr std::size_t value_size = 16;
+            tyson::Writer writer {text_.size() + value_size * slots_.size()};
+            write(writer, values...);
+            return writer;
+        }
+
+        /**
+         *
+         * @return the written query with the values bound
+         */
+        template<typename ...T>
+        [[nodiscard]] std::string str(const T &...values) const
+        {
+            return bind(values...).take();
+        }
+    };
+
+
+    class Query
+    {
+        std::string collection_name_;
+        std::vector<std::unique_ptr<annadb::Query::QueryCmd>> cmds_ {};
+        void add_to_cmds(std::unique_ptr<QueryCmd> queryCmd)
+        {
+            auto previous = cmds_.empty() ? Step::None : cmds_.back()->step();
+            if (!step_allowed(previous, queryCmd->step()))
+            {
+                if (cmds_.empty())
                 {
-                    throw std::invalid_argument(queryCmd->name() + " can not be used before/after " + cmds_.at(latest_cmd)->name());
+                    throw std::invalid_argument(std::string(queryCmd->name()) + " can not be used to start a new query pipeline.");
                 }
+                throw std::invalid_argument(std::string(queryCmd->name()) + " can not be used before/after " + std::string(cmds_.back()->name()));
             }
+
+            this->cmds_.emplace_back(std::move(queryCmd));
         }
 
-        friend std::ostream& operator<<(std::ostream &out, Query &query) noexcept
+        /**
+         * The beginning of a query which holds only the statement step, exampl.: collection|users|:insert[
+         */
+        [[nodiscard]] std::string query_head(Step step) const
         {
-            std::stringstream sstream;
-            sstream << "collection|" << query.collection_name_ << "|";
+            return "collection|" + collection_name_ + "|:" + std::string(step_name(step)) + "[";
+        }
 
-            if (query.cmds_.size() == 1)
+        void write_statements(tyson::Writer &writer)
+        {
+            // grow once for large payloads instead of doubling the buffer while it is written
+            constexpr std::size_t statement_overhead = 64;
+            std::size_t known = collection_name_.size() + statement_overhead;
+            for (const auto &cmd: cmds_)
             {
-                sstream << ":" << query.cmds_[0]->query() << ";";
+                known += cmd->known_size();
+            }
+            writer.reserve(writer.size() + known);
+
+            writer.raw("collection|").raw(collection_name_).raw('|');
+
+            if (cmds_.size() == 1)
+            {
+                writer.raw(':');
+                cmds_[0]->write(writer);
+                writer.raw(';');
             }
             else
             {
-                sstream << ":q[";
-                for (auto &cmd: query.cmds_)
+                writer.raw(":q[");
+                for (auto &cmd: cmds_)
                 {
-                    sstream << cmd->query() << ",";
+                    cmd->write(writer);
+                    writer.separator();
                 }
-                sstream << "];";
+                writer.raw("];");
             }
-            return out << sstream.str();
+        }
+
+        friend std::ostream& operator<<(std::ostream &out, Query &query)
+        {
+            tyson::Writer writer {};
+            query.write(writer);
+            return out << writer.view();
         }
 
     public:
@@ -829,8 +1079,68 @@ namespace annadb::Query
          * @param collection_name
          */
         explicit Query(std::string collection_name) : collection_name_(std::move(collection_name)) {};
+        Query(Query &&) noexcept = default;
+        Query& operator=(Query &&) noexcept = default;
         ~Query() = default;
 
+        /**
+         * Write the whole query, every statement is appended to the same buffer
+         *
+         * @param writer exampl.: collection|test|:insert[n|10|,];
+         * @throw invalid_argument if the query holds a Param, use prepare for it, the writer is left unchanged
+         */
+        void write(tyson::Writer &writer)
+        {
+            auto size = writer.size();
+            auto params = writer.params().size();
+            write_statements(writer);
+            if (writer.params().size() != params)
+            {
+                writer.truncate(size, params);
+                throw std::invalid_argument("The query holds a Param and must be prepared before it is written");
+            }
+        }
+
+        /**
+         * Write the whole query into a new buffer, the query is used up by it.
+         * The records of an insert created by Query::insert are already encoded behind
+         * the beginning of the query and become the written query without being copied.
+         *
+         * exampl.: db.send(std::move(query))
+         *
+         * @return the written query, exampl.: collection|test|:insert[n|10|,];
+         * @throw invalid_argument if the query holds a Param, use prepare for it
+         */
+        [[nodiscard]] tyson::Writer write() &&
+        {
+            if (cmds_.size() == 1 && cmds_[0]->step() == Step::Insert)
+            {
+                auto query = static_cast<Insert &>(*cmds_[0]).take_query(query_head(Step::Insert));
+                if (query)
+                {
+                    return std::move(*query);
+                }
+            }
+
+            tyson::Writer writer {};
+            write(writer);
+            return writer;
+        }
+
+        /**
+         * Write the query once to bind only its parameters on every call afterwards,
+         * the pipeline of the query is not validated again for the prepared query
+         *
+         * @return @see query.annadb::Query::PreparedQuery
+         * @throw invalid_argument if the Param indices are not contiguous from 0
+         */
+        [[nodiscard]] PreparedQuery prepare()
+        {
+            tyson::Writer writer {};
+            write_statements(writer);
+            return PreparedQuery {writer};
+        }
+
         /**
          * Create Insert statement
          *
@@ -861,6 +1171,24 @@ namespace annadb::Query
             this->add_to_cmds(std::make_unique<Insert>(insert));
         }
     
+        /**
+         * Create Insert statement from any input range, the records are encoded while the range is read
+         *
+         * exampl.: query.insert(users);
+         *          query.insert(lines | std::views::transform(parse_user));
+         *
+         * @param records TySonObjects or structs described by tyson::Describe
+         */
+        template<std::ranges::input_range R>
+        requires InsertRecord<std::ranges::range_value_t<R>>
+        void insert(R &&records)
+        {
+            // the records are encoded behind the beginning of the query, so write() && can hand them over
+            auto insert = std::make_unique<Insert>();
+            insert->encode_records(query_head(Step::Insert), std::forward<R>(records));
+            this->add_to_cmds(std::move(insert));
+        }
+
         /**
          * Create Insert statement
          *
@@ -972,6 +1300,18 @@ namespace annadb::Query
             return *this;
         }
 
+        /**
+         * Create Limit statement whose value is bound by the prepared query
+         *
+         * @param limit @see query_comparision.annadb::Query::Param
+         * @return the query class to add additional statements
+         */
+        Query& limit(Param limit)
+        {
+            this->add_to_cmds(std::make_unique<Limit>(limit));
+            return *this;
+        }
+
         /**
          * Create Offset statement
          *
@@ -999,6 +1339,18 @@ namespace annadb::Query
             return *this;
         }
 
+        /**
+         * Create Offset statement whose value is bound by the prepared query
+         *
+         * @param offset @see query_comparision.annadb::Query::Param
+         * @return the query class to add additional statements
+         */
+        Query& offset(Param offset)
+        {
+            this->add_to_cmds(std::make_unique<Offset>(offset));
+            return *this;
+        }
+
         /**
          * Create Update statement
          *
@@ -1097,6 +1449,114 @@ namespace annadb::Query
             return *this;
         }
     };
+
+    /**
+     * Builds a Query whose pipeline is checked while compiling.
+     * Every statement returns the builder of the next state, statements which can not follow the last one
+     * do not exist for it, so an illegal pipeline does not compile.
+     * The arguments of the statements are the same as the ones of Query.
+     *
+     * exampl.:
+     *      auto query = Pipeline("test").find(Find::GT(min_num)).limit(10).build();
+     *      Pipeline("test").insert(obj).limit(10);    // does not compile
+     *
+     * @tparam Last the last statement of the pipeline
+     */
+    template<Step Last = Step::None>
+    class Pipeline
+    {
+        Query query_;
+
+        template<Step>
+        friend class Pipeline;
+
+        explicit Pipeline(Query &&query) noexcept : query_(std::move(query)) {}
+
+        template<Step Next>
+        [[nodiscard]] Pipeline<Next> next() noexcept
+        {
+            return Pipeline<Next> {std::move(query_)};
+        }
+
+    public:
+        /**
+         * Start a new pipeline
+         *
+         * @param collection_name
+         */
+        explicit Pipeline(std::string collection_name) requires (Last == Step::None)
+            : query_(std::move(collection_name))
+        {}
+
+        template<typename ...T>
+        [[nodiscard]] Pipeline<Step::Insert> insert(T &&...values) && requires (step_allowed(Last, Step::Insert))
+        {
+            query_.insert(std::forward<T>(values)...);
+            return next<Step::Insert>();
+        }
+
+        template<typename ...T>
+        [[nodiscard]] Pipeline<Step::Get> get(T &&...values) && requires (step_allowed(Last, Step::Get))
+        {
+            query_.get(std::forward<T>(values)...);
+            return next<Step::Get>();
+        }
+
+        [[nodiscard]] Pipeline<Step::Find> find(Find &&find) && requires (step_allowed(Last, Step::Find))
+        {
+            query_.find(std::move(find));
+            return next<Step::Find>();
+        }
+
+        [[nodiscard]] Pipeline<Step::Sort> sort(Sort &&sort) && requires (step_allowed(Last, Step::Sort))
+        {
+            query_.sort(std::move(sort));
+            return next<Step::Sort>();
+        }
+
+        template<typename T>
+        [[nodiscard]] Pipeline<Step::Limit> limit(T &&limit) && requires (step_allowed(Last, Step::Limit))
+        {
+            query_.limit(std::forward<T>(limit));
+            return next<Step::Limit>();
+        }
+
+        template<typename T>
+        [[nodiscard]] Pipeline<Step::Offset> offset(T &&offset) && requires (step_allowed(Last, Step::Offset))
+        {
+            query_.offset(std::forward<T>(offset));
+            return next<Step::Offset>();
+        }
+
+        template<typename ...T>
+        [[nodiscard]] Pipeline<Step::Update> update(T &&...values) && requires (step_allowed(Last, Step::Update))
+        {
+            query_.update(std::forward<T>(values)...);
+            return next<Step::Update>();
+        }
+
+        [[nodiscard]] Pipeline<Step::Delete> delete_q() && requires (step_allowed(Last, Step::Delete))
+        {
+            query_.delete_q();
+            return next<Step::Delete>();
+        }
+
+        template<typename ...T>
+        [[nodiscard]] Pipeline<Step::Project> project(T &&...values) && requires (step_allowed(Last, Step::Project))
+        {
+            query_.project(std::forward<T>(values)...);
+            return next<Step::Project>();
+        }
+
+        /**
+         *
+         * @return the built query, @see query.annadb::Query::Query
+         */
+        [[nodiscard]] Query build() && requires (Last != Step::None)
+        {
+            return std::move(query_);
+        }
+    };
 }
 
 #endif //ANNADB_DRIVER_QUERY_HPP
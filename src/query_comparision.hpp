@@ -27,7 +27,12 @@ In order to compare a field of the object path to value notation could be used:
 #ifndef ANNADB_DRIVER_QUERY_COMPARISION_HPP
 #define ANNADB_DRIVER_QUERY_COMPARISION_HPP
 
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "TySON.hpp"
 
@@ -49,179 +54,388 @@ namespace annadb::Query
         OR,
         NOT
     };
-    
+
     /**
-     * The Base class for all comparison options
+     *
+     * @return true if the comparison compares a field with a value
      */
-    class Comparison
+    constexpr bool compares_value(ComparisonType type) noexcept
+    {
+        return type <= ComparisonType::LTE;
+    }
+
+    /**
+     *
+     * @return the name which is written in front of the comparison, exampl.: eq
+     */
+    constexpr std::string_view comparison_name(ComparisonType type) noexcept
     {
-        tyson::TySonObject value_;
-        
-        [[nodiscard]] virtual std::string to_string()
+        switch (type)
         {
-            std::stringstream sstream;
-            sstream << name_ << "{";
-            
-            if (field_ == "root")
+            case ComparisonType::EQ:
+                return "eq";
+            case ComparisonType::NEQ:
+                return "neq";
+            case ComparisonType::GT:
+                return "gt";
+            case ComparisonType::GTE:
+                return "gte";
+            case ComparisonType::LT:
+                return "lt";
+            case ComparisonType::LTE:
+                return "lte";
+            case ComparisonType::AND:
+                return "and";
+            case ComparisonType::OR:
+                return "or";
+            default:
+                return "not";
+        }
+    }
+
+    /**
+     * A placeholder for a value which is bound later, a query holding one must be prepared
+     *
+     * exampl.: Eq("user_id", Param {0}) => eq{value|user_id|: <first bound value>}
+     * @see query.annadb::Query::Query::prepare
+     */
+    struct Param
+    {
+        std::size_t index;
+    };
+
+    /**
+     * The comparisons of a filter as a tree inside of one contiguous pool.
+     * Every node is followed by the nodes of its children, the compared values and field paths
+     * are stored in one vector and one string, so a filter is built and written in a single pass.
+     */
+    class Filter
+    {
+    public:
+        struct Node
+        {
+            ComparisonType type;
+            // number of nodes of the subtree including this one
+            std::uint32_t size = 1;
+            // the path of the field inside of fields_, empty compares the root
+            std::uint32_t field_begin = 0;
+            std::uint32_t field_size = 0;
+            // the position inside of values_ or the index of the Param
+            std::uint32_t value = 0;
+            bool param = false;
+        };
+
+    private:
+        std::vector<Node> nodes_ {};
+        std::vector<tyson::TySonObject> values_ {};
+        std::string fields_ {};
+
+        void add_node(ComparisonType type, std::string_view field, std::size_t value, bool param)
+        {
+            // root compares the whole value and is written without a path, an excluded field keeps its name
+            if (compares_value(type) && field == "root")
             {
-                sstream << "root: ";
+                field = {};
             }
-            else
+            nodes_.push_back({type, 1, static_cast<std::uint32_t>(fields_.size()),
+                              static_cast<std::uint32_t>(field.size()), static_cast<std::uint32_t>(value), param});
+            fields_ += field;
+        }
+
+        void append_nodes(const Filter &other)
+        {
+            auto field_offset = static_cast<std::uint32_t>(fields_.size());
+            auto value_offset = static_cast<std::uint32_t>(values_.size());
+            for (auto node : other.nodes_)
             {
-                sstream << "value|" << field_ << "|: ";
+                node.field_begin += field_offset;
+                if (compares_value(node.type) && !node.param)
+                {
+                    node.value += value_offset;
+                }
+                nodes_.push_back(node);
             }
-            
-            sstream << value_ << "}";
-            return sstream.str();
+            fields_ += other.fields_;
         }
-        
-        friend std::ostream &operator<<(std::ostream &out, Comparison &obj)
+
+        [[nodiscard]] std::string_view field(const Node &node) const noexcept
         {
-            return out << obj.to_string();
+            return std::string_view {fields_}.substr(node.field_begin, node.field_size);
         }
-    
-    protected:
-        std::string field_;
-        std::string name_;
-    
+
     public:
-        explicit Comparison(std::string_view &field, std::string_view name) : value_(tyson::TySonObject::Null()),
-                                                                              field_(field), name_(name)
-        {}
-        
-        explicit Comparison(std::string field, std::string_view name) : value_(tyson::TySonObject::Null()),
-                                                                        field_(std::move(field)), name_(name)
-        {}
-        
-        template<std::convertible_to<tyson::TySonObject> T>
-        explicit
-        Comparison(T value, std::string_view name) : value_(std::forward<tyson::TySonObject>(value)), field_("root"),
-                                                     name_(name)
-        {}
-        
-        Comparison(tyson::TySonObject &value, std::string_view field, std::string_view name) : value_(value),
-                                                                                               field_(field),
-                                                                                               name_(name)
-        {}
-        
-        virtual ~Comparison() = default;
-        
-        std::string str()
+        /**
+         * Compare a field with a value
+         *
+         * @param type one of EQ, NEQ, GT, GTE, LT, LTE
+         * @param field the path to the field, root compares the whole value
+         * @param value @see TySON.tyson::TySonObject
+         */
+        void compare(ComparisonType type, std::string_view field, tyson::TySonObject value)
         {
-            return to_string();
+            add_node(type, field, values_.size(), false);
+            values_.emplace_back(std::move(value));
         }
-        
-        ComparisonType type()
+
+        /**
+         * Compare a field with a value which is bound by the prepared query
+         */
+        void compare(ComparisonType type, std::string_view field, Param param)
         {
-            if (name_ == "eq")
-            {
-                return ComparisonType::EQ;
-            }
-            else if (name_ == "neq")
-            {
-                return ComparisonType::NEQ;
-            }
-            else if (name_ == "gt")
-            {
-                return ComparisonType::GT;
-            }
-            else if (name_ == "gte")
-            {
-                return ComparisonType::GTE;
-            }
-            else if (name_ == "lt")
-            {
-                return ComparisonType::LT;
-            }
-            else if (name_ == "lte")
-            {
-                return ComparisonType::LTE;
-            }
-            else if (name_ == "and")
-            {
-                return ComparisonType::AND;
-            }
-            else if (name_ == "or")
+            add_node(type, field, param.index, true);
+        }
+
+        /**
+         * Exclude a specific field
+         */
+        void exclude(std::string_view field)
+        {
+            add_node(ComparisonType::NOT, field, 0, false);
+        }
+
+        /**
+         * Start an And or Or, every node added until end_logical is one of its children
+         *
+         * @return the position to pass to end_logical
+         */
+        std::size_t begin_logical(ComparisonType type)
+        {
+            add_node(type, {}, 0, false);
+            return nodes_.size() - 1;
+        }
+
+        void end_logical(std::size_t pos) noexcept
+        {
+            nodes_[pos].size = static_cast<std::uint32_t>(nodes_.size() - pos);
+        }
+
+        /**
+         * Append all comparisons of another filter
+         */
+        void append(const Filter &other)
+        {
+            append_nodes(other);
+            values_.insert(values_.end(), other.values_.begin(), other.values_.end());
+        }
+
+        void append(Filter &&other)
+        {
+            append_nodes(other);
+            values_.insert(values_.end(), std::make_move_iterator(other.values_.begin()),
+                           std::make_move_iterator(other.values_.end()));
+        }
+
+        /**
+         * Reserve the pool for a number of comparisons
+         */
+        void reserve(std::size_t comparisons)
+        {
+            nodes_.reserve(comparisons);
+            values_.reserve(comparisons);
+        }
+
+        [[nodiscard]] std::span<const Node> nodes() const noexcept
+        {
+            return nodes_;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return nodes_.empty();
+        }
+
+        /**
+         * Write the comparison at pos with all of its children
+         *
+         * @param writer exampl.: and[gt{value|num|: n|5|},lt{value|num|: n|9|},]
+         * @param pos the position of the node
+         * @return the position of the next comparison on the same level
+         */
+        std::size_t write(tyson::Writer &writer, std::size_t pos) const
+        {
+            const auto &node = nodes_[pos];
+            switch (node.type)
             {
-                return ComparisonType::OR;
+                case ComparisonType::AND:
+                case ComparisonType::OR:
+                    writer.raw(comparison_name(node.type)).raw('[');
+                    for (auto child = pos + 1; child < pos + node.size;)
+                    {
+                        child = write(writer, child);
+                        writer.separator();
+                    }
+                    writer.raw(']');
+                    break;
+                case ComparisonType::NOT:
+                    writer.raw("not(value|").raw(field(node)).raw("|)");
+                    break;
+                default:
+                    writer.raw(comparison_name(node.type)).raw('{');
+                    if (node.field_size == 0)
+                    {
+                        writer.raw("root: ");
+                    }
+                    else
+                    {
+                        writer.raw("value|").raw(field(node)).raw("|: ");
+                    }
+
+                    if (node.param)
+                    {
+                        writer.param(node.value);
+                    }
+                    else
+                    {
+                        writer.value(values_[node.value]);
+                    }
+                    writer.raw('}');
+                    break;
             }
-            else
+            return pos + node.size;
+        }
+
+        /**
+         * Write every comparison on the top level, each one is followed by a `,`
+         */
+        void write(tyson::Writer &writer) const
+        {
+            for (std::size_t pos = 0; pos < nodes_.size();)
             {
-                return ComparisonType::NOT;
+                pos = write(writer, pos);
+                writer.separator();
             }
         }
     };
 
+    /**
+     * The Base class for all comparison options, it holds one comparison including all of its children
+     * and can be copied without losing them
+     */
+    class Comparison
+    {
+        friend std::ostream &operator<<(std::ostream &out, const Comparison &obj)
+        {
+            return out << obj.str();
+        }
+
+    protected:
+        Filter filter_;
+
+        Comparison() = default;
+
+    public:
+        Comparison(ComparisonType type, tyson::TySonObject value, std::string_view field = "root")
+        {
+            filter_.compare(type, field, std::move(value));
+        }
+
+        Comparison(ComparisonType type, Param param, std::string_view field = "root")
+        {
+            filter_.compare(type, field, param);
+        }
+
+        /**
+         * Append the comparison to the query which is written
+         *
+         * @param writer exampl.: gt{value|num|: n|5|}
+         */
+        void write(tyson::Writer &writer) const
+        {
+            filter_.write(writer, 0);
+        }
+
+        [[nodiscard]] std::string str() const
+        {
+            tyson::Writer writer {};
+            write(writer);
+            return writer.take();
+        }
+
+        [[nodiscard]] ComparisonType type() const noexcept
+        {
+            return filter_.nodes().front().type;
+        }
+
+        [[nodiscard]] const Filter& filter() const & noexcept
+        {
+            return filter_;
+        }
+
+        [[nodiscard]] Filter&& filter() && noexcept
+        {
+            return std::move(filter_);
+        }
+    };
+
+    /**
+     * A comparison of a field with a value
+     *
+     * @tparam Type one of EQ, NEQ, GT, GTE, LT, LTE
+     */
+    template<ComparisonType Type>
+    class Compare : public Comparison
+    {
+    public:
+        explicit Compare(const tyson::TySonObject &value) : Comparison(Type, value) {};
+        Compare(std::string_view path_to_field, const tyson::TySonObject &value) : Comparison(Type, value, path_to_field) {};
+        explicit Compare(tyson::TySonObject &&value) : Comparison(Type, std::move(value)) {};
+        Compare(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(Type, std::move(value), path_to_field) {};
+        explicit Compare(Param param) : Comparison(Type, param) {};
+        Compare(std::string_view path_to_field, Param param) : Comparison(Type, param, path_to_field) {};
+    };
+
     /**
      * The equal comparison class
      */
-    class Eq : public Comparison
+    class Eq : public Compare<ComparisonType::EQ>
     {
     public:
-        explicit Eq(tyson::TySonObject &value) : Comparison(value, "eq") {};
-        Eq(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "eq") {};
-        explicit Eq(tyson::TySonObject &&value) : Comparison(value, "eq") {};
-        Eq(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "eq") {};
+        using Compare::Compare;
     };
 
     /**
      * The not equal comparison class
      */
-    class Neq : public Comparison
+    class Neq : public Compare<ComparisonType::NEQ>
     {
     public:
-        explicit Neq(tyson::TySonObject &value) : Comparison(value, "neq") {};
-        Neq(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "neq") {};
-        explicit Neq(tyson::TySonObject &&value) : Comparison(value, "neq") {};
-        Neq(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "neq") {};
+        using Compare::Compare;
     };
     
     /**
      * The greater comparison class
      */
-    class Gt : public Comparison
+    class Gt : public Compare<ComparisonType::GT>
     {
     public:
-        explicit Gt(tyson::TySonObject &value) : Comparison(value, "gt") {};
-        Gt(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "gt") {};
-        explicit Gt(tyson::TySonObject &&value) : Comparison(value, "gt") {};
-        Gt(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "gt") {};
+        using Compare::Compare;
     };
     
     /**
      * The greater or equal comparison class
      */
-    class Gte : public Comparison
+    class Gte : public Compare<ComparisonType::GTE>
     {
     public:
-        explicit Gte(tyson::TySonObject &value) : Comparison(value, "gte") {};
-        Gte(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "gte") {};
-        explicit Gte(tyson::TySonObject &&value) : Comparison(value, "gte") {};
-        Gte(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "gte") {};
+        using Compare::Compare;
     };
     
     /**
      * The less comparison class
      */
-    class Lt : public Comparison
+    class Lt : public Compare<ComparisonType::LT>
     {
     public:
-        explicit Lt(tyson::TySonObject &value) : Comparison(value, "lt") {};
-        Lt(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "lt") {};
-        explicit Lt(tyson::TySonObject &&value) : Comparison(value, "lt") {};
-        Lt(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "lt") {};
+        using Compare::Compare;
     };
     
     /**
      * The less or equal comparison class
      */
-    class Lte : public Comparison
+    class Lte : public Compare<ComparisonType::LTE>
     {
     public:
-        explicit Lte(const tyson::TySonObject &value) : Comparison(value, "lte") {};
-        Lte(std::string_view path_to_field, tyson::TySonObject &value) : Comparison(value, path_to_field, "lte") {};
-        explicit Lte(const tyson::TySonObject &&value) : Comparison(value, "lte") {};
-        Lte(std::string_view path_to_field, tyson::TySonObject &&value) : Comparison(value, path_to_field, "lte") {};
+        using Compare::Compare;
     };
     
     /**
@@ -229,28 +443,17 @@ namespace annadb::Query
      */
     class And : public Comparison
     {
-        std::vector<Comparison> compares_{};
-        
-        [[nodiscard]] std::string to_string() override
-        {
-            std::stringstream sstream;
-            sstream << "and[";
-            
-            std::for_each(compares_.begin(), compares_.end(), [&sstream](Comparison &val) { sstream << val << ","; });
-            sstream << "]";
-            return sstream.str();
-        }
-    
     public:
         /**
          * Initialise `And` comparison class
          * @param comps a variadic number of comparison objects which should be included in the `And` clause
          */
-        template<std::convertible_to<Comparison> ...Comps>
-        And(Comps ...comps) : Comparison("", "and")
+        template<std::derived_from<Comparison> ...Comps>
+        And(const Comps &...comps)
         {
-            compares_.reserve(sizeof ...(comps));
-            (compares_.emplace_back(comps), ...);
+            auto pos = filter_.begin_logical(ComparisonType::AND);
+            (filter_.append(comps.filter()), ...);
+            filter_.end_logical(pos);
         }
     };
     
@@ -259,28 +462,17 @@ namespace annadb::Query
      */
     class Or : public Comparison
     {
-        std::vector<Comparison> compares_{};
-        
-        [[nodiscard]] std::string to_string() override
-        {
-            std::stringstream sstream;
-            sstream << "or[";
-            
-            std::for_each(compares_.begin(), compares_.end(), [&sstream](Comparison &val) { sstream << val << ","; });
-            sstream << "]";
-            return sstream.str();
-        }
-    
     public:
         /**
          * Initialise the `Or` comparison
          * @param comps a variadic number of comparison objects which should be included in the `Or` clause
          */
-        template<std::convertible_to<Comparison> ...Comps>
-        explicit Or(Comps ...comps) : Comparison("", "or")
+        template<std::derived_from<Comparison> ...Comps>
+        explicit Or(const Comps &...comps)
         {
-            compares_.reserve(sizeof ...(comps));
-            (compares_.emplace_back(comps), ...);
+            auto pos = filter_.begin_logical(ComparisonType::OR);
+            (filter_.append(comps.filter()), ...);
+            filter_.end_logical(pos);
         }
     };
     
@@ -289,14 +481,11 @@ namespace annadb::Query
      */
     class Not : public Comparison
     {
-        [[nodiscard]] std::string to_string() override
+    public:
+        explicit Not(std::string_view field)
         {
-            return name_ + "(value|" + field_ + "|)";
+            filter_.exclude(field);
         }
-    
-    public:
-        explicit Not(std::string_view field) : Comparison(field, "not")
-        {};
     };
     
 }
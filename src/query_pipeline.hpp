@@ -0,0 +1,108 @@
+#ifndef ANNADB_DRIVER_QUERY_PIPELINE_HPP
+#define ANNADB_DRIVER_QUERY_PIPELINE_HPP
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Which statements of a query pipeline can follow each other.
+ * Every statement is one bit, so the rules are a few masks which are checked without allocating
+ * and can be used by the runtime Query as well as at compile time.
+ */
+namespace annadb::Query
+{
+    enum class Step : std::uint16_t
+    {
+        None = 0,
+        Insert = 1 << 0,
+        Get = 1 << 1,
+        Find = 1 << 2,
+        Sort = 1 << 3,
+        Limit = 1 << 4,
+        Offset = 1 << 5,
+        Update = 1 << 6,
+        Delete = 1 << 7,
+        Project = 1 << 8,
+    };
+
+    constexpr Step operator|(Step lhs, Step rhs) noexcept
+    {
+        return static_cast<Step>(static_cast<std::uint16_t>(lhs) | static_cast<std::uint16_t>(rhs));
+    }
+
+    /**
+     *
+     * @param mask one or more steps
+     * @return true if step is part of mask
+     */
+    constexpr bool contains(Step mask, Step step) noexcept
+    {
+        return (static_cast<std::uint16_t>(mask) & static_cast<std::uint16_t>(step)) != 0;
+    }
+
+    // statements which select the values the following statements work on
+    constexpr Step filter_steps = Step::Find | Step::Get | Step::Sort | Step::Limit | Step::Offset;
+    constexpr Step start_steps = Step::Insert | Step::Get | Step::Find;
+
+    /**
+     *
+     * @return the statements which can follow step
+     */
+    constexpr Step next_steps(Step step) noexcept
+    {
+        return contains(filter_steps, step) ? filter_steps | Step::Update | Step::Delete | Step::Project : Step::None;
+    }
+
+    /**
+     *
+     * @return the statements step can follow
+     */
+    constexpr Step previous_steps(Step step) noexcept
+    {
+        return contains(filter_steps | Step::Update | Step::Delete | Step::Project, step) ? filter_steps : Step::None;
+    }
+
+    /**
+     *
+     * @param previous the last statement of the pipeline, Step::None for an empty one
+     * @param next the statement which should be added
+     * @return true if next can be added to the pipeline
+     */
+    constexpr bool step_allowed(Step previous, Step next) noexcept
+    {
+        if (previous == Step::None)
+        {
+            return contains(start_steps, next);
+        }
+        return contains(next_steps(previous), next) && contains(previous_steps(next), previous);
+    }
+
+    constexpr std::string_view step_name(Step step) noexcept
+    {
+        switch (step)
+        {
+            case Step::Insert:
+                return "insert";
+            case Step::Get:
+                return "get";
+            case Step::Find:
+                return "find";
+            case Step::Sort:
+                return "sort";
+            case Step::Limit:
+                return "limit";
+            case Step::Offset:
+                return "offset";
+            case Step::Update:
+                return "update";
+            case Step::Delete:
+                return "delete";
+            case Step::Project:
+                return "project";
+            default:
+                return "";
+        }
+    }
+}
+
+#endif //ANNADB_DRIVER_QUERY_PIPELINE_HPP
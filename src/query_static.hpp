@@ -0,0 +1,433 @@
+#ifndef ANNADB_DRIVER_QUERY_STATIC_HPP
+#define ANNADB_DRIVER_QUERY_STATIC_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "TySON.hpp"
+#include "TySON_struct.hpp"
+#include "query_pipeline.hpp"
+
+/**
+ * Queries whose shape is known at compile time.
+ * The pipeline is checked by the compiler and the TySON text around the values is built as static data,
+ * so writing such a query only writes its values.
+ *
+ * exampl.:
+ *      using namespace annadb::Query::Static;
+ *      using UserById = StaticQuery<"users", Find<Eq<"user_id">>, Limit<>>;
+ *
+ *      auto journal = db.send(UserById::bind(42, 10));
+ *      // => collection|users|:q[find[eq{value|user_id|: n|42|},],limit(n|10|),];
+ */
+namespace annadb::Query::Static
+{
+    /**
+     * Counts the chars and value slots of a static query to size its Layout
+     */
+    struct Counter
+    {
+        std::size_t chars = 0;
+        std::size_t slots = 0;
+
+        constexpr void raw(std::string_view text) noexcept
+        {
+            chars += text.size();
+        }
+
+        constexpr void slot(bool) noexcept
+        {
+            ++slots;
+        }
+    };
+
+    /**
+     * The static text of a query and the positions where its values are written
+     *
+     * @tparam Chars number of chars of the static text
+     * @tparam Slots number of values
+     */
+    template<std::size_t Chars, std::size_t Slots>
+    struct Layout
+    {
+        std::array<char, Chars> text {};
+        std::array<std::size_t, Slots> offsets {};
+        // the value of the slot must be a Number, e.g. for limit
+        std::array<bool, Slots> numbers {};
+        std::size_t chars = 0;
+        std::size_t slots = 0;
+
+        constexpr void raw(std::string_view text_part) noexcept
+        {
+            for (auto chr : text_part)
+            {
+                text[chars++] = chr;
+            }
+        }
+
+        constexpr void slot(bool number) noexcept
+        {
+            offsets[slots] = chars;
+            numbers[slots++] = number;
+        }
+    };
+
+    template<typename Out>
+    constexpr void render_number(Out &out, std::size_t number) noexcept
+    {
+        char buffer[20] {};
+        std::size_t pos = sizeof(buffer);
+        do
+        {
+            buffer[--pos] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number);
+        out.raw(std::string_view {buffer + pos, sizeof(buffer) - pos});
+    }
+
+    /**
+     * A comparison of a field with a value given when the query is written
+     *
+     * @tparam Name exampl.: eq
+     * @tparam Field the path to the field, root compares the whole value
+     */
+    template<tyson::fixed_string Name, tyson::fixed_string Field>
+    struct Compare
+    {
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw(Name.view());
+            if constexpr (Field.view() == "root")
+            {
+                out.raw("{root: ");
+            }
+            else
+            {
+                out.raw("{value|");
+                out.raw(Field.view());
+                out.raw("|: ");
+            }
+            out.slot(false);
+            out.raw("}");
+        }
+    };
+
+    template<tyson::fixed_string Field = "root">
+    using Eq = Compare<"eq", Field>;
+
+    template<tyson::fixed_string Field = "root">
+    using Neq = Compare<"neq", Field>;
+
+    template<tyson::fixed_string Field = "root">
+    using Gt = Compare<"gt", Field>;
+
+    template<tyson::fixed_string Field = "root">
+    using Gte = Compare<"gte", Field>;
+
+    template<tyson::fixed_string Field = "root">
+    using Lt = Compare<"lt", Field>;
+
+    template<tyson::fixed_string Field = "root">
+    using Lte = Compare<"lte", Field>;
+
+    /**
+     * Exclude a specific field
+     */
+    template<tyson::fixed_string Field>
+    struct Not
+    {
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw("not(value|");
+            out.raw(Field.view());
+            out.raw("|)");
+        }
+    };
+
+    /**
+     * Combine comparisons, exampl.: Logical<"and", Gt<"num">, Lt<"num">>
+     */
+    template<tyson::fixed_string Name, typename... Comps>
+    struct Logical
+    {
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw(Name.view());
+            out.raw("[");
+            ((Comps::render(out), out.raw(",")), ...);
+            out.raw("]");
+        }
+    };
+
+    template<typename... Comps>
+    using And = Logical<"and", Comps...>;
+
+    template<typename... Comps>
+    using Or = Logical<"or", Comps...>;
+
+    /**
+     * Sort by a field
+     *
+     * @tparam Name asc or desc
+     */
+    template<tyson::fixed_string Name, tyson::fixed_string Field>
+    struct Order
+    {
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw(Name.view());
+            out.raw("(value|");
+            out.raw(Field.view());
+            out.raw("|)");
+        }
+    };
+
+    template<tyson::fixed_string Field>
+    using Asc = Order<"asc", Field>;
+
+    template<tyson::fixed_string Field>
+    using Desc = Order<"desc", Field>;
+
+    /**
+     * A statement whose values are all given when the query is written
+     *
+     * @tparam S exampl.: Step::Insert
+     * @tparam Count number of values
+     */
+    template<Step S, std::size_t Count>
+    struct Values
+    {
+        static constexpr Step step = S;
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw(step_name(step));
+            out.raw("[");
+            for (std::size_t i = 0; i < Count; ++i)
+            {
+                out.slot(false);
+                out.raw(",");
+            }
+            out.raw("]");
+        }
+    };
+
+    template<std::size_t Count = 1>
+    using Insert = Values<Step::Insert, Count>;
+
+    template<std::size_t Count = 1>
+    using Get = Values<Step::Get, Count>;
+
+    template<typename... Comps>
+    struct Find
+    {
+        static constexpr Step step = Step::Find;
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw("find[");
+            ((Comps::render(out), out.raw(",")), ...);
+            out.raw("]");
+        }
+    };
+
+    template<typename... Orders>
+    struct Sort
+    {
+        static constexpr Step step = Step::Sort;
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw("sort[");
+            ((Orders::render(out), out.raw(",")), ...);
+            out.raw("]");
+        }
+    };
+
+    /**
+     * limit or offset, exampl.: Limit<10> is part of the static text, Limit<> is a Number given when written
+     */
+    template<Step S, std::size_t... Value>
+    requires (sizeof...(Value) <= 1)
+    struct Amount
+    {
+        static constexpr Step step = S;
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw(step_name(step));
+            if constexpr (sizeof...(Value) == 0)
+            {
+                out.raw("(");
+                out.slot(true);
+            }
+            else
+            {
+                out.raw("(n|");
+                (render_number(out, Value), ...);
+                out.raw("|");
+            }
+            out.raw(")");
+        }
+    };
+
+    template<std::size_t... Value>
+    using Limit = Amount<Step::Limit, Value...>;
+
+    template<std::size_t... Value>
+    using Offset = Amount<Step::Offset, Value...>;
+
+    struct Delete
+    {
+        static constexpr Step step = Step::Delete;
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw("delete");
+        }
+    };
+
+    /**
+     * A query whose statements are known at compile time, only the values are written at runtime.
+     * An illegal pipeline does not compile.
+     *
+     * @tparam Collection the name of the collection
+     * @tparam Steps the statements, exampl.: Find<Gt<"num">>, Sort<Asc<"num">>, Limit<>
+     */
+    template<tyson::fixed_string Collection, typename... Steps>
+    requires (sizeof...(Steps) > 0)
+    class StaticQuery
+    {
+        static constexpr std::array<Step, sizeof...(Steps)> steps_ {Steps::step...};
+
+        static constexpr bool pipeline_allowed() noexcept
+        {
+            for (std::size_t i = 1; i < steps_.size(); ++i)
+            {
+                if (!step_allowed(steps_[i - 1], steps_[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(step_allowed(Step::None, steps_.front()), "the first statement can not start a query pipeline");
+        static_assert(pipeline_allowed(), "a statement can not be used before/after the previous one");
+
+        template<typename Out>
+        static constexpr void render(Out &out) noexcept
+        {
+            out.raw("collection|");
+            out.raw(Collection.view());
+            if constexpr (sizeof...(Steps) == 1)
+            {
+                out.raw("|:");
+                (Steps::render(out), ...);
+                out.raw(";");
+            }
+            else
+            {
+                out.raw("|:q[");
+                ((Steps::render(out), out.raw(",")), ...);
+                out.raw("];");
+            }
+        }
+
+        static constexpr Counter counted_ = []
+        {
+            Counter counter {};
+            render(counter);
+            return counter;
+        }();
+
+        static constexpr auto layout_ = []
+        {
+            Layout<counted_.chars, counted_.slots> layout {};
+            render(layout);
+            return layout;
+        }();
+
+        template<std::size_t I, typename T>
+        static void write_value(tyson::Writer &writer, const T &value)
+        {
+            if constexpr (layout_.numbers[I])
+            {
+                static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                              "the value must be a number");
+            }
+
+            constexpr std::size_t begin = I == 0 ? 0 : layout_.offsets[I - 1];
+            writer.raw(text().substr(begin, layout_.offsets[I] - begin));
+            tyson::encode(value, writer);
+        }
+
+    public:
+        // the number of values write expects
+        static constexpr std::size_t params = counted_.slots;
+
+        /**
+         *
+         * @return the static text of the query without its values
+         */
+        [[nodiscard]] static constexpr std::string_view text() noexcept
+        {
+            return {layout_.text.data(), layout_.text.size()};
+        }
+
+        /**
+         * Append the query with its values
+         *
+         * @param writer the query is appended to it
+         * @param values one value per slot in the order of the statements
+         */
+        template<typename... T>
+        requires (sizeof...(T) == params)
+        static void write(tyson::Writer &writer, const T &...values)
+        {
+            [&writer, &values...]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                (write_value<I>(writer, values), ...);
+            }(std::index_sequence_for<T...> {});
+
+            constexpr std::size_t end = params == 0 ? 0 : layout_.offsets[params - 1];
+            writer.raw(text().substr(end));
+        }
+
+        /**
+         * Write the query with its values into a new Writer which can be sent
+         *
+         * exampl.: db.send(UserById::bind(42, 10))
+         */
+        template<typename... T>
+        requires (sizeof...(T) == params)
+        [[nodiscard]] static tyson::Writer bind(const T &...values)
+        {
+            // most values are short numbers or strings
+            constexpr std::size_t value_size = 16;
+            tyson::Writer writer {text().size() + value_size * params};
+            write(writer, values...);
+            return writer;
+        }
+
+        template<typename... T>
+        requires (sizeof...(T) == params)
+        [[nodiscard]] static std::string str(const T &...values)
+        {
+            return bind(values...).take();
+        }
+    };
+}
+
+#endif //ANNADB_DRIVER_QUERY_STATIC_HPP
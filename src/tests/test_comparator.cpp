@@ -110,4 +110,46 @@ TEST(annadb_query_find, find_not_field)
         sstream << eq_root;
         ASSERT_EQ(sstream.str(), "not(value|name|)");
     }
+    {
+        std::stringstream sstream;
+        
+        // only compared values map root to the whole value, an excluded field keeps the name
+        auto not_root = annadb::Query::Not("root");
+        
+        sstream << not_root;
+        ASSERT_EQ(sstream.str(), "not(value|root|)");
+    }
+}
+
+TEST(annadb_query_find, nested_and_or)
+{
+    auto num_1 = tyson::TySonObject::Number(5);
+    auto num_2 = tyson::TySonObject::Number(9);
+    auto inner = annadb::Query::And(annadb::Query::Gt("num", num_1), annadb::Query::Lt("num", num_2));
+    auto outer = annadb::Query::Or(inner, annadb::Query::Not("deleted"), annadb::Query::Eq(num_2));
+    
+    ASSERT_EQ(inner.type(), annadb::Query::ComparisonType::AND);
+    ASSERT_EQ(outer.type(), annadb::Query::ComparisonType::OR);
+    ASSERT_EQ(outer.filter().nodes().size(), 6);
+    
+    // a copy keeps all nested comparisons
+    annadb::Query::Comparison copy = outer;
+    ASSERT_EQ(copy.str(),
+              "or[and[gt{value|num|: n|5|},lt{value|num|: n|9|},],not(value|deleted|),eq{root: n|9|},]");
+}
+
+TEST(annadb_query_find, filter_pool)
+{
+    annadb::Query::Filter filter {};
+    filter.reserve(3);
+    filter.compare(annadb::Query::ComparisonType::GTE, "a", tyson::TySonObject::Number(1));
+    auto pos = filter.begin_logical(annadb::Query::ComparisonType::OR);
+    filter.compare(annadb::Query::ComparisonType::NEQ, "b", tyson::TySonObject::String("x"));
+    filter.exclude("c");
+    filter.end_logical(pos);
+    filter.append(annadb::Query::Lte("d", tyson::TySonObject::Number(2)).filter());
+    
+    tyson::Writer writer {};
+    filter.write(writer);
+    ASSERT_EQ(writer.view(), "gte{value|a|: n|1|},or[neq{value|b|: s|x|},not(value|c|),],lte{value|d|: n|2|},");
 }
@@ -1,6 +1,8 @@
 //
 // Created by felix on 05.02.23.
 //
+#include <array>
+#include <thread>
 #include "gtest/gtest.h"
 #include "../TySON.hpp"
 #include "../connection.hpp"
@@ -90,6 +92,180 @@ TEST(tyson_parsing_connection_data, get_objects_by_collection_name)
     ASSERT_EQ(obj_links.size(), 3);
 }
 
+TEST(tyson_parsing_connection_data, get_objects_with_links_inside_of_values)
+{
+    annadb::Data data {"s|data|:objects{\n"
+                       "    test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|:s|a,test|,\n"
+                       "    test|d261580c-1c7f-4cf0-a231-be4a25486146|:m{s|note|:s|b,test_data|,},\n"
+                       "}"};
+
+    auto obj = data.get<tyson::TySonType::Objects>();
+    ASSERT_TRUE(obj.has_value());
+    ASSERT_EQ(obj.value().get<tyson::TySonType::Objects>("test").size(), 2);
+
+    auto first = obj.value().get<tyson::TySonType::Object>("d08412fb-9d7e-4d8f-8905-c7355a67ff70");
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first.value().second.value<tyson::TySonType::String>(), "a,test");
+}
+
+TEST(tyson_parsing_connection_data, walk_objects)
+{
+    struct Fold
+    {
+        std::map<std::string, int> per_collection {};
+        bool is_num = false;
+        long sum = 0;
+
+        void on_key(const tyson::TySonToken &key)
+        {
+            if (key.type == tyson::TySonType::Link)
+            {
+                ++per_collection[std::string(key.tag)];
+            }
+            is_num = key.value == "num";
+        }
+        void on_number(std::string_view val)
+        {
+            if (is_num)
+            {
+                sum += std::stol(std::string(val));
+            }
+        }
+    };
+
+    annadb::Data data {only_map_data};
+    Fold fold;
+    ASSERT_TRUE(data.walk(fold));
+    ASSERT_EQ(fold.sum, 0 + 1 + 2 + 3 + 4);
+    ASSERT_EQ(fold.per_collection["test"], 3);
+    ASSERT_EQ(fold.per_collection["test_data"], 2);
+}
+
+TEST(tyson_parsing_connection_data, walk_ids)
+{
+    struct Ids
+    {
+        std::vector<std::string> ids {};
+        void on_link(std::string_view, std::string_view id) { ids.emplace_back(id); }
+    };
+
+    annadb::Data data {id_response};
+    Ids ids;
+    ASSERT_TRUE(data.walk(ids));
+    ASSERT_EQ(ids.ids.size(), 4);
+    ASSERT_EQ(ids.ids[0], "4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+}
+
+TEST(tyson_parsing_connection_data, collection_lookups_with_mixed_collections)
+{
+    tyson::TySonCollectionObject ids {};
+    ids.add("test|4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+    ids.add("other|3677c916-ac4d-40ab-89f4-def1e565e7ab");
+    ids.add("test|5ff00377-34ac-43b9-8ebb-71bb5ff78ebf");
+
+    ASSERT_EQ(ids.get<tyson::TySonType::IDs>("test").size(), 2);
+    ASSERT_EQ(ids.get<tyson::TySonType::IDs>("other").size(), 1);
+    ASSERT_TRUE(ids.get<tyson::TySonType::IDs>("missing").empty());
+    ASSERT_TRUE(ids.get<tyson::TySonType::ID>("other", "3677c916-ac4d-40ab-89f4-def1e565e7ab").has_value());
+    ASSERT_FALSE(ids.get<tyson::TySonType::ID>("test", "3677c916-ac4d-40ab-89f4-def1e565e7ab").has_value());
+
+    // adding rebuilds the index on the next lookup
+    ids.add("other|7bdd7c8f-e9da-42f6-b473-5a6fd9a1c90f");
+    ASSERT_EQ(ids.get<tyson::TySonType::IDs>("other").size(), 2);
+    ASSERT_TRUE(ids.get<tyson::TySonType::ID>("7bdd7c8f-e9da-42f6-b473-5a6fd9a1c90f").has_value());
+
+    auto copy = ids;
+    ASSERT_EQ(copy.get<tyson::TySonType::IDs>("test").size(), 2);
+    for (const auto &id : copy.get<tyson::TySonType::IDs>("test"))
+    {
+        ASSERT_EQ(id.value<tyson::TySonType::Link>().first, "test");
+    }
+}
+
+TEST(tyson_parsing_connection_data, lookups_of_the_wrong_kind)
+{
+    tyson::TySonCollectionObject ids {};
+    ids.add("test|4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+
+    ASSERT_FALSE(ids.get<tyson::TySonType::Object>("4339ace2-9ab3-4c79-b557-f9b78d66b7f9").has_value());
+    ASSERT_FALSE(ids.get<tyson::TySonType::Object>("test", "4339ace2-9ab3-4c79-b557-f9b78d66b7f9").has_value());
+    ASSERT_TRUE(ids.get<tyson::TySonType::Objects>("test").empty());
+    ASSERT_TRUE(ids.get<tyson::TySonType::ID>("4339ace2-9ab3-4c79-b557-f9b78d66b7f9").has_value());
+
+    annadb::Data data {only_map_data};
+    const auto &objects = data.get<tyson::TySonType::Objects>().value();
+    ASSERT_FALSE(objects.get<tyson::TySonType::ID>("d08412fb-9d7e-4d8f-8905-c7355a67ff70").has_value());
+    ASSERT_FALSE(objects.get<tyson::TySonType::ID>("test", "d08412fb-9d7e-4d8f-8905-c7355a67ff70").has_value());
+    ASSERT_TRUE(objects.get<tyson::TySonType::IDs>("test").empty());
+    ASSERT_TRUE(objects.get<tyson::TySonType::Object>("d08412fb-9d7e-4d8f-8905-c7355a67ff70").has_value());
+}
+
+TEST(tyson_parsing_connection_data, lookups_keep_the_order_of_the_entries)
+{
+    tyson::TySonCollectionObject ids {};
+    ids.add("test|4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+    ids.add("other|3677c916-ac4d-40ab-89f4-def1e565e7ab");
+    ids.add("test|5ff00377-34ac-43b9-8ebb-71bb5ff78ebf");
+    ids.add("another|7bdd7c8f-e9da-42f6-b473-5a6fd9a1c90f");
+    ids.add("test|2b908538-2ec5-4970-8a65-30f7e3f6302c");
+
+    std::vector<std::string> test_ids {};
+    for (const auto &id : ids.get<tyson::TySonType::IDs>("test"))
+    {
+        test_ids.emplace_back(id.value<tyson::TySonType::Link>().second);
+    }
+    std::vector<std::string> expected {"4339ace2-9ab3-4c79-b557-f9b78d66b7f9", "5ff00377-34ac-43b9-8ebb-71bb5ff78ebf",
+                                       "2b908538-2ec5-4970-8a65-30f7e3f6302c"};
+    ASSERT_EQ(test_ids, expected);
+    ASSERT_EQ(ids.get<tyson::TySonType::IDs>("another")[0].value<tyson::TySonType::Link>().first, "another");
+}
+
+TEST(tyson_parsing_connection_data, concurrent_lookups)
+{
+    annadb::Data data {only_map_data};
+    const auto &objects = data.get<tyson::TySonType::Objects>().value();
+
+    std::array<std::size_t, 4> found {};
+    {
+        std::vector<std::jthread> threads {};
+        for (std::size_t i = 0; i < found.size(); ++i)
+        {
+            threads.emplace_back([&objects, &found, i]
+                                 {
+                                     found[i] = objects.get<tyson::TySonType::Objects>("test").size();
+                                 });
+        }
+    }
+    ASSERT_EQ(found, (std::array<std::size_t, 4> {3, 3, 3, 3}));
+}
+
+TEST(tyson_parsing_connection_data, ids_which_are_no_uuid)
+{
+    tyson::TySonCollectionObject ids {};
+    ids.add("test|4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+    ids.add("test|admin");
+    ids.add("other|admin");
+
+    ASSERT_EQ(ids.get<tyson::TySonType::ID>("admin")->value<tyson::TySonType::Link>().second, "admin");
+    ASSERT_EQ(ids.get<tyson::TySonType::ID>("other", "admin")->value<tyson::TySonType::Link>().first, "other");
+    ASSERT_FALSE(ids.get<tyson::TySonType::ID>("missing", "admin").has_value());
+    ASSERT_TRUE(ids.get<tyson::TySonType::ID>("4339ace2-9ab3-4c79-b557-f9b78d66b7f9").has_value());
+}
+
+TEST(tyson_parsing_connection_data, collection_names_are_shared)
+{
+    annadb::Data data {only_map_data};
+    auto objects = data.get<tyson::TySonType::Objects>()->get<tyson::TySonType::Objects>("test");
+    ASSERT_EQ(objects.size(), 3);
+    ASSERT_EQ(objects[0].first.link_collection().data(), objects[2].first.link_collection().data());
+
+    std::array<std::byte, 1024> buffer {};
+    std::pmr::monotonic_buffer_resource resource {buffer.data(), buffer.size()};
+    tyson::TySonObject copy {objects[0].first, &resource};
+    ASSERT_NE(copy.link_collection().data(), objects[0].first.link_collection().data());
+    ASSERT_EQ(copy, objects[0].first);
+}
+
 TEST(tyson_parsing_connection_data, get_meta_data_type)
 {
     annadb::Meta meta {"s|meta|:insert_meta{s|count|:n|1|,}"};
@@ -118,3 +294,219 @@ TEST(tyson_parsing_connection_data, get_meta_data_value)
         ASSERT_EQ(meta.rows<short>(), expected);
     }
 }
+
+TEST(tyson_parsing_connection_data, journal_response)
+{
+    annadb::Journal journal {"result:ok[response{" + only_map_data + ",s|meta|:find_meta{s|count|:n|5|,},},];"};
+    
+    ASSERT_TRUE(journal.ok());
+    ASSERT_EQ(journal.meta().type(), annadb::MetaType::find_meta);
+    ASSERT_EQ(journal.meta().rows<int>(), 5);
+    
+    auto objects = journal.data().get<tyson::TySonType::Objects>();
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_EQ(objects.value().get<tyson::TySonType::Objects>("test").size(), 3);
+}
+
+TEST(tyson_parsing_connection_data, journal_response_with_separators_in_values)
+{
+    annadb::Journal journal {"result:ok[\n"
+                             "    response{\n"
+                             "        s|data|:ids[test|9e1691d3-fbd6-4444-8175-1957f2871c45|,],\n"
+                             "        s|meta|:insert_meta{\n"
+                             "            s|count|:n|1|,\n"
+                             "            s|note|:s|,s|meta|:}],|,\n"
+                             "        },\n"
+                             "    },\n"
+                             "];"};
+    
+    ASSERT_TRUE(journal.ok());
+    ASSERT_EQ(journal.meta().type(), annadb::MetaType::insert_meta);
+    ASSERT_EQ(journal.meta().rows<int>(), 1);
+    ASSERT_TRUE(journal.data().get<tyson::TySonType::IDs>().has_value());
+}
+
+TEST(tyson_parsing_connection_data, journal_parts_are_cached)
+{
+    annadb::Journal journal {"result:ok[response{" + only_map_data + ",s|meta|:find_meta{s|count|:n|5|,},},];"};
+
+    ASSERT_EQ(&journal.meta(), &journal.meta());
+    ASSERT_EQ(&journal.data(), &journal.data());
+    ASSERT_EQ(&journal.data().get<tyson::TySonType::Objects>(), &journal.data().get<tyson::TySonType::Objects>());
+    ASSERT_FALSE(journal.data().get<tyson::TySonType::IDs>().has_value());
+    ASSERT_EQ(journal.meta().rows<int>(), 5);
+}
+
+TEST(tyson_parsing_connection_data, journal_concurrent_reads)
+{
+    const annadb::Journal journal {"result:ok[response{" + only_map_data + ",s|meta|:find_meta{s|count|:n|5|,},},];"};
+
+    // every thread must see the same parts, they are built once
+    std::array<const tyson::TySonCollectionObject *, 4> collections {};
+    std::array<const annadb::Meta *, 4> metas {};
+    {
+        std::vector<std::jthread> threads {};
+        for (std::size_t i = 0; i < collections.size(); ++i)
+        {
+            threads.emplace_back([&journal, &collections, &metas, i]
+                                 {
+                                     metas[i] = &journal.meta();
+                                     collections[i] = &journal.data().get<tyson::TySonType::Objects>().value();
+                                 });
+        }
+    }
+
+    for (std::size_t i = 1; i < collections.size(); ++i)
+    {
+        ASSERT_EQ(collections[i], collections[0]);
+        ASSERT_EQ(metas[i], metas[0]);
+    }
+    ASSERT_EQ(collections[0]->get<tyson::TySonType::Objects>("test").size(), 3);
+
+    // a copy builds its own parts
+    auto copy = journal;
+    ASSERT_NE(&copy.data(), &journal.data());
+    ASSERT_EQ(copy.meta().rows<int>(), 5);
+}
+
+TEST(tyson_parsing_connection_data, journal_with_memory_resource)
+{
+    std::pmr::monotonic_buffer_resource arena {};
+    annadb::Journal journal {"result:ok[response{" + only_map_data + ",s|meta|:find_meta{s|count|:n|5|,},},];", &arena};
+
+    const auto &objects = journal.data().get<tyson::TySonType::Objects>();
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_EQ(objects.value().get_allocator().resource(), &arena);
+    ASSERT_EQ(objects.value().get<tyson::TySonType::Objects>("test").size(), 3);
+}
+
+TEST(tyson_parsing_connection_data, journal_error_response)
+{
+    annadb::Journal journal {"result:error[response{s|data|:ids[],s|meta|:insert_meta{s|count|:n|0|,},},];"};
+    ASSERT_FALSE(journal.ok());
+}
+
+TEST(bulk_insert, chunk_sizer)
+{
+    annadb::BulkInsertOptions options {};
+    options.initial_records = 100;
+    options.min_records = 10;
+    options.max_records = 300;
+    options.target_latency = std::chrono::milliseconds {10};
+
+    annadb::ChunkSizer sizer {options};
+    ASSERT_EQ(sizer.records(), 100);
+
+    sizer.observe(std::chrono::milliseconds {1});
+    ASSERT_EQ(sizer.records(), 200);
+    sizer.observe(std::chrono::milliseconds {1});
+    ASSERT_EQ(sizer.records(), 300);
+
+    // between half of the target and the target the size is kept
+    sizer.observe(std::chrono::milliseconds {7});
+    ASSERT_EQ(sizer.records(), 300);
+
+    // a response which was only read after the next chunk was encoded does not shrink the chunks
+    sizer.observe(std::chrono::milliseconds {20}, true);
+    ASSERT_EQ(sizer.records(), 300);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        sizer.observe(std::chrono::milliseconds {20});
+    }
+    ASSERT_EQ(sizer.records(), 10);
+
+    options.min_records = 0;
+    ASSERT_THROW(annadb::ChunkSizer {options}, std::invalid_argument);
+}
+
+TEST(bulk_insert, write_insert_chunk)
+{
+    std::vector<tyson::TySonObject> records {};
+    for (int i = 0; i < 5; ++i)
+    {
+        records.push_back(tyson::TySonObject::Number(i));
+    }
+
+    auto first = records.begin();
+    tyson::Writer writer {};
+    ASSERT_EQ(annadb::write_insert_chunk(writer, "test", first, records.end(), 2, 1024), 2);
+    ASSERT_EQ(writer.view(), "collection|test|:insert[n|0|,n|1|,];");
+
+    // the chunk ends after the record which reaches max_bytes
+    writer.clear();
+    ASSERT_EQ(annadb::write_insert_chunk(writer, "test", first, records.end(), 10, 30), 2);
+    ASSERT_EQ(writer.view(), "collection|test|:insert[n|2|,n|3|,];");
+
+    writer.clear();
+    ASSERT_EQ(annadb::write_insert_chunk(writer, "test", first, records.end(), 10, 1024), 1);
+    ASSERT_EQ(writer.view(), "collection|test|:insert[n|4|,];");
+
+    writer.clear();
+    ASSERT_EQ(annadb::write_insert_chunk(writer, "test", first, records.end(), 10, 1024), 0);
+    ASSERT_TRUE(writer.view().empty());
+}
+
+TEST(get_fan_out, write_get_chunk)
+{
+    std::vector<tyson::TySonObject> links {
+            tyson::TySonObject {"test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|"},
+            tyson::TySonObject {"test|d261580c-1c7f-4cf0-a231-be4a25486146|"},
+    };
+
+    tyson::Writer writer {};
+    annadb::write_get_chunk(writer, "test", links);
+    ASSERT_EQ(writer.view(), "collection|test|:get["
+                             "test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|,"
+                             "test|d261580c-1c7f-4cf0-a231-be4a25486146|,"
+                             "];");
+}
+
+TEST(get_fan_out, merge_in_request_order)
+{
+    std::vector<tyson::TySonObject> links {
+            tyson::TySonObject {"test|2b908538-2ec5-4970-8a65-30f7e3f6302c|"},
+            tyson::TySonObject {"test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|"},
+            // not part of any response
+            tyson::TySonObject {"test|e0bbcda2-0911-495e-9f0f-ce00db489f10|"},
+            tyson::TySonObject {"test|d261580c-1c7f-4cf0-a231-be4a25486146|"},
+            tyson::TySonObject {"other|custom_id|"},
+    };
+
+    // sub requests of two links, AnnaDB answers with its own order
+    std::vector<annadb::Journal> responses {
+            annadb::Journal {"result:ok[response{s|data|:objects{"
+                             "test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|:n|0|,"
+                             "test|2b908538-2ec5-4970-8a65-30f7e3f6302c|:n|2|,"
+                             "},s|meta|:get_meta{s|count|:n|2|,},},];"},
+            annadb::Journal {"result:ok[response{s|data|:objects{"
+                             "test|d261580c-1c7f-4cf0-a231-be4a25486146|:n|1|,"
+                             "},s|meta|:get_meta{s|count|:n|1|,},},];"},
+            annadb::Journal {"result:ok[response{s|data|:objects{"
+                             "other|custom_id|:s|custom|,"
+                             "},s|meta|:get_meta{s|count|:n|1|,},},];"},
+    };
+
+    auto merged = annadb::merge_get_responses(links, responses, 2);
+
+    auto objects = merged.get<tyson::TySonType::Objects>("test");
+    ASSERT_EQ(objects.size(), 3);
+    ASSERT_EQ(objects[0].second.value<int>(), 2);
+    ASSERT_EQ(objects[1].second.value<int>(), 0);
+    ASSERT_EQ(objects[2].second.value<int>(), 1);
+    ASSERT_FALSE(merged.get<tyson::TySonType::Object>("e0bbcda2-0911-495e-9f0f-ce00db489f10").has_value());
+
+    auto other = merged.get<tyson::TySonType::Objects>("other");
+    ASSERT_EQ(other.size(), 1);
+    ASSERT_EQ(other[0].second.value<tyson::TySonType::String>(), "custom");
+}
+
+TEST(get_fan_out, empty_links)
+{
+    // nothing is sent for an empty list, so it works without a connection
+    annadb::AnnaDB db {"user", "password", "localhost", 10001};
+    auto objects = db.get("test", {});
+
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_EQ(objects->get<tyson::TySonType::Objects>("test").size(), 0);
+}
@@ -4,6 +4,7 @@
 
 #include "gtest/gtest.h"
 #include "../query.hpp"
+#include "../connection.hpp"
 
 TEST(annadb_query, create_single_element_insert_query_v1)
 {
@@ -414,3 +415,100 @@ TEST(annadb_query, create_project_query)
                   "collection|users|:q[find[],sort[asc(value|name|),],project{s|name|:v[value|name|,],s|emails|:v[s|TEST|,keep,],},];");
     }
 }
+
+TEST(annadb_query, prepared_query)
+{
+    using namespace annadb::Query;
+    
+    Find find {};
+    find.q(Eq("user_id", Param {0})).q(Lt(Param {2}));
+    
+    auto query = Query("test");
+    query.find(std::move(find)).limit(Param {1});
+    auto prepared = query.prepare();
+    
+    ASSERT_EQ(prepared.params(), 3);
+    ASSERT_EQ(prepared.str(42, 10, tyson::TySonObject::Number(7)),
+              "collection|test|:q[find[eq{value|user_id|: n|42|},lt{root: n|7|},],limit(n|10|),];");
+    ASSERT_EQ(prepared.str("jondoe", 1, 2.5),
+              "collection|test|:q[find[eq{value|user_id|: s|jondoe|},lt{root: n|2.5|},],limit(n|1|),];");
+    
+    tyson::Writer writer {};
+    prepared.write(writer, 1, 2, 3);
+    ASSERT_EQ(writer.view(), "collection|test|:q[find[eq{value|user_id|: n|1|},lt{root: n|3|},],limit(n|2|),];");
+    ASSERT_TRUE(writer.params().empty());
+    
+    ASSERT_THROW(static_cast<void>(prepared.str(1, 2)), std::invalid_argument);
+    ASSERT_THROW(static_cast<void>(prepared.str(1, "ten", 3)), std::invalid_argument);
+    ASSERT_THROW(static_cast<void>(prepared.str(1, tyson::TySonObject::Null(), 3)), std::invalid_argument);
+    
+    // a value of the wrong type is found after the text before it was written, the writer is left unchanged
+    ASSERT_THROW(prepared.write(writer, 1, "ten", 3), std::invalid_argument);
+    ASSERT_EQ(writer.view(), "collection|test|:q[find[eq{value|user_id|: n|1|},lt{root: n|3|},],limit(n|2|),];");
+    
+    // every index up to the largest one must be used, a value for a missing one would be dropped
+    Find gaps {};
+    gaps.q(Eq("user_id", Param {0})).q(Lt(Param {2}));
+    auto gap_query = Query("test");
+    gap_query.find(std::move(gaps));
+    ASSERT_THROW(static_cast<void>(gap_query.prepare()), std::invalid_argument);
+    
+    // a query holding a Param can not be written without its values, nothing is left behind in the writer
+    ASSERT_THROW(query.write(writer), std::invalid_argument);
+    ASSERT_EQ(writer.view(), "collection|test|:q[find[eq{value|user_id|: n|1|},lt{root: n|3|},],limit(n|2|),];");
+    ASSERT_TRUE(writer.params().empty());
+    
+    std::stringstream sstream;
+    ASSERT_THROW(sstream << query, std::invalid_argument);
+    annadb::AnnaDB db {"user", "password", "localhost", 10001};
+    ASSERT_THROW((void)db.send(query), std::invalid_argument);
+}
+
+TEST(annadb_query, pipeline_steps)
+{
+    using namespace annadb::Query;
+    
+    static_assert(step_allowed(Step::None, Step::Find));
+    static_assert(!step_allowed(Step::None, Step::Limit));
+    static_assert(step_allowed(Step::Find, Step::Limit));
+    static_assert(step_allowed(Step::Sort, Step::Project));
+    static_assert(!step_allowed(Step::Insert, Step::Find));
+    static_assert(!step_allowed(Step::Delete, Step::Find));
+    
+    auto query = Query("test");
+    ASSERT_THROW(query.limit(Param {0}), std::invalid_argument);
+    query.find(Find::GT(tyson::TySonObject::Number(5))).limit<short>(6);
+    query.delete_q();
+    ASSERT_THROW(query.limit(Param {0}), std::invalid_argument);
+}
+
+template<typename P>
+concept can_limit = requires (P pipeline) { std::move(pipeline).limit(1); };
+
+template<typename P>
+concept can_build = requires (P pipeline) { std::move(pipeline).build(); };
+
+TEST(annadb_query, type_state_pipeline)
+{
+    using namespace annadb::Query;
+    
+    auto query = Pipeline("test").find(Find::GT(tyson::TySonObject::Number(5))).sort(Sort::ASC("some"))
+                                 .limit(6).delete_q().build();
+    std::stringstream sstream;
+    sstream << query;
+    ASSERT_EQ(sstream.str(), "collection|test|:q[find[gt{root: n|5|},],sort[asc(value|some|),],limit(n|6|),delete,];");
+    
+    auto link = tyson::TySonObject::Link("test", "b2279b93-00b3-4b44-9670-82a76922c0da");
+    auto get = Pipeline("test").get(link).build();
+    sstream.str("");
+    sstream << get;
+    ASSERT_EQ(sstream.str(), "collection|test|:get[test|b2279b93-00b3-4b44-9670-82a76922c0da|,];");
+    
+    // statements which can not follow are not part of the builder
+    using Inserted = decltype(Pipeline("test").insert(tyson::TySonObject::Number(1)));
+    static_assert(!can_limit<Inserted>);
+    static_assert(can_build<Inserted>);
+    static_assert(!can_limit<Pipeline<>>);
+    static_assert(!can_build<Pipeline<>>);
+    static_assert(can_limit<Pipeline<Step::Find>>);
+}
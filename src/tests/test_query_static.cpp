@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "../query.hpp"
+#include "../query_static.hpp"
+
+using namespace annadb::Query::Static;
+
+TEST(annadb_static_query, static_text)
+{
+    using Query = StaticQuery<"users", Find<Eq<"user_id">, Not<"deleted">>, Sort<Asc<"name">, Desc<"age">>, Limit<10>>;
+    
+    static_assert(Query::params == 1);
+    static_assert(Query::text() == "collection|users|:q[find[eq{value|user_id|: },not(value|deleted|),],"
+                                   "sort[asc(value|name|),desc(value|age|),],limit(n|10|),];");
+    
+    ASSERT_EQ(Query::str(42),
+              "collection|users|:q[find[eq{value|user_id|: n|42|},not(value|deleted|),],"
+              "sort[asc(value|name|),desc(value|age|),],limit(n|10|),];");
+}
+
+TEST(annadb_static_query, not_root_is_equal_to_the_runtime_query)
+{
+    annadb::Query::Find find {};
+    find.q(annadb::Query::Not("root"));
+    auto query = annadb::Query::Query("users");
+    query.find(std::move(find));
+    std::stringstream sstream;
+    sstream << query;
+    
+    ASSERT_EQ(sstream.str(), (StaticQuery<"users", Find<Not<"root">>>::text()));
+    ASSERT_EQ(sstream.str(), "collection|users|:find[not(value|root|),];");
+}
+
+TEST(annadb_static_query, values)
+{
+    using Query = StaticQuery<"test", Find<Or<Gt<>, Lte<"num">>>, Offset<>, Limit<>>;
+    static_assert(Query::params == 4);
+    
+    ASSERT_EQ(Query::str(5, tyson::TySonObject::Number(10), 2, 3),
+              "collection|test|:q[find[or[gt{root: n|5|},lte{value|num|: n|10|},],],offset(n|2|),limit(n|3|),];");
+    
+    tyson::Writer writer {};
+    StaticQuery<"test", Insert<2>>::write(writer, std::string("a"), 1.5);
+    ASSERT_EQ(writer.view(), "collection|test|:insert[s|a|,n|1.5|,];");
+    
+    ASSERT_EQ((StaticQuery<"test", Find<>, Delete>::str()), "collection|test|:q[find[],delete,];");
+}
+
+TEST(annadb_static_query, same_text_as_query)
+{
+    using Query = StaticQuery<"test", Get<1>, Limit<6>>;
+    
+    auto link = tyson::TySonObject::Link("test", "b2279b93-00b3-4b44-9670-82a76922c0da");
+    auto query = annadb::Query::Query("test");
+    query.get(link).limit<short>(6);
+    std::stringstream sstream;
+    sstream << query;
+    
+    ASSERT_EQ(Query::str(link), sstream.str());
+}
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "../TySON.hpp"
+
+
+TEST(tyson_index, structural_positions)
+{
+    std::string raw = "s|a,b|:v[n|1|,]";
+    tyson::StructuralIndex index {raw, tyson::SimdLevel::Scalar};
+    
+    std::vector<std::uint32_t> expected {1, 5, 6, 8, 10, 12, 13, 14};
+    ASSERT_EQ(index.positions(), expected);
+}
+
+TEST(tyson_index, scan_is_equal_to_the_index)
+{
+    // inputs larger than max_size are scanned instead of indexed
+    std::string raw = "m{s|a,b|:v[n|1|,],s|c[]{}:|:s||,}";
+    tyson::StructuralIndex index {raw};
+    
+    std::vector<std::uint32_t> scanned {};
+    tyson::StructuralIndex::scan(raw, [&scanned](std::size_t pos) { scanned.push_back(static_cast<std::uint32_t>(pos)); });
+    ASSERT_EQ(scanned, index.positions());
+    ASSERT_EQ(tyson::StructuralIndex::max_size, std::numeric_limits<std::uint32_t>::max());
+}
+
+TEST(tyson_index, all_levels_are_equal)
+{
+    std::string raw;
+    for (int i = 0; i < 100; ++i)
+    {
+        // values with structural chars crossing the 64 byte blocks
+        raw += "m{s|key_" + std::to_string(i) + "|:s|" + std::string(static_cast<std::size_t>(i), ',') + "[{}]:|,"
+               "s|list|:v[n|" + std::to_string(i) + "|,b|true|,],},";
+    }
+    
+    tyson::StructuralIndex scalar {raw, tyson::SimdLevel::Scalar};
+    tyson::StructuralIndex sse {raw, tyson::SimdLevel::SSE42};
+    tyson::StructuralIndex avx {raw, tyson::SimdLevel::AVX2};
+    tyson::StructuralIndex detected {raw};
+    
+    ASSERT_EQ(scalar.positions(), sse.positions());
+    ASSERT_EQ(scalar.positions(), avx.positions());
+    ASSERT_EQ(scalar.positions(), detected.positions());
+    
+    for (auto pos : scalar.positions())
+    {
+        ASSERT_NE(std::string_view("|,:[]{}").find(raw[pos]), std::string_view::npos);
+    }
+}
+
+TEST(tyson_index, indexed_parser_is_equal)
+{
+    std::string raw = "v[";
+    for (int i = 0; i < 500; ++i)
+    {
+        raw += "m{s|num|:n|" + std::to_string(i) + "|,s|text|:s|a, b: [c] {d}|,s|nested|:v[m{s|x|:null,},],},";
+    }
+    raw += "]";
+    
+    tyson::StructuralIndex index {raw};
+    auto indexed = tyson::TySonParser(raw, index).parse();
+    auto plain = tyson::TySonParser(raw).parse();
+    
+    ASSERT_EQ(indexed.type(), tyson::TySonType::Vector);
+    ASSERT_EQ(indexed.value<tyson::TySonType::Vector>().size(), 500);
+    ASSERT_EQ(indexed, plain);
+    ASSERT_EQ(tyson::TySonObject(raw), plain);
+}
+
+TEST(tyson_index, indexed_skip_of_sub_string)
+{
+    std::string raw = "s|data|:objects{test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|:m{s|a|:s|}]|,},}";
+    tyson::StructuralIndex index {raw};
+    
+    auto body = std::string_view(raw).substr(raw.find('{') + 1);
+    tyson::TySonParser parser {body, index};
+    
+    auto link = parser.next();
+    ASSERT_EQ(link.type, tyson::TySonType::Link);
+    ASSERT_TRUE(parser.consume(':'));
+    
+    auto value = parser.next();
+    ASSERT_EQ(value.type, tyson::TySonType::Map);
+    ASSERT_EQ(value.raw, "m{s|a|:s|}]|,}");
+}
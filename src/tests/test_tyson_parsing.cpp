@@ -2,6 +2,7 @@
 // Created by felix on 01.02.23.
 //
 #include "gtest/gtest.h"
+#include <array>
 #include "../TySON.hpp"
 
 
@@ -267,3 +268,328 @@ TEST(tyson_parsing, emplace_can_only_be_used_with_maps)
                  std::invalid_argument);
     ASSERT_THROW(tyson_vector.emplace("Allowed", tyson::TySonObject::Bool(false)), std::invalid_argument);
 }
+
+TEST(tyson_parsing, nested_map_type)
+{
+    tyson::TySonObject object{"m{s|name|:s|test|,s|inner|:m{s|num|:n|1|,s|list|:v[n|1|,m{s|deep|:b|true|,},],},}"};
+    
+    ASSERT_EQ(object.type(), tyson::TySonType::Map);
+    ASSERT_EQ(object.value<tyson::TySonType::Map>().size(), 2);
+    
+    auto inner = object["inner"];
+    ASSERT_TRUE(inner.has_value());
+    ASSERT_EQ(inner.value().type(), tyson::TySonType::Map);
+    ASSERT_EQ(inner.value()["num"].value().value<int>(), 1);
+    
+    auto list = inner.value()["list"].value().value<tyson::TySonType::Vector>();
+    ASSERT_EQ(list.size(), 2);
+    ASSERT_EQ(list[1].type(), tyson::TySonType::Map);
+    ASSERT_TRUE(list[1]["deep"].value().value<tyson::TySonType::Bool>());
+}
+
+TEST(tyson_parsing, string_with_separators)
+{
+    tyson::TySonObject object{"m{s|text|:s|foo, bar: baz|,s|list|:v[s|a,b|,s|c:d|,],}"};
+    
+    ASSERT_EQ(object.type(), tyson::TySonType::Map);
+    ASSERT_EQ(object["text"].value().value<tyson::TySonType::String>(), "foo, bar: baz");
+    
+    auto list = object["list"].value().value<tyson::TySonType::Vector>();
+    ASSERT_EQ(list.size(), 2);
+    ASSERT_EQ(list[0].value<tyson::TySonType::String>(), "a,b");
+    ASSERT_EQ(list[1].value<tyson::TySonType::String>(), "c:d");
+}
+
+TEST(tyson_parsing, whitespace_and_empty_containers)
+{
+    tyson::TySonObject object{"m{ s|bar|: s|baz|, s|empty|: v[], s|none|: null,}"};
+    
+    ASSERT_EQ(object.type(), tyson::TySonType::Map);
+    ASSERT_EQ(object["bar"].value().value<tyson::TySonType::String>(), "baz");
+    ASSERT_TRUE(object["empty"].value().value<tyson::TySonType::Vector>().empty());
+    ASSERT_EQ(object["none"].value().type(), tyson::TySonType::Null);
+}
+
+TEST(tyson_parsing, deep_nesting)
+{
+    const std::size_t depth = 200;
+    std::string raw;
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        raw += "v[";
+    }
+    raw += "n|1|,";
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        raw += "],";
+    }
+    
+    tyson::TySonObject object{raw};
+    std::size_t found_depth = 0;
+    while (object.type() == tyson::TySonType::Vector)
+    {
+        ++found_depth;
+        auto inner = object.value<tyson::TySonType::Vector>();
+        ASSERT_EQ(inner.size(), 1);
+        object = inner[0];
+    }
+    
+    ASSERT_EQ(found_depth, depth);
+    ASSERT_EQ(object.value<int>(), 1);
+}
+
+TEST(tyson_parsing, serialize_parsed_roundtrip)
+{
+    std::stringstream sstream;
+    std::string raw = "m{s|a|:v[n|1|,s|x, y|,],s|b|:m{s|c|:b|true|,},}";
+    tyson::TySonObject object{raw};
+    
+    sstream << object;
+    ASSERT_EQ(sstream.str(), raw);
+}
+
+TEST(tyson_parsing, walk_events)
+{
+    struct Recorder
+    {
+        std::vector<std::string> events {};
+
+        void begin_vector() { events.emplace_back("["); }
+        void end_vector() { events.emplace_back("]"); }
+        void begin_map() { events.emplace_back("{"); }
+        void end_map() { events.emplace_back("}"); }
+        void on_key(const tyson::TySonToken &key) { events.emplace_back("key:" + std::string(key.value)); }
+        void on_link(std::string_view collection, std::string_view id)
+        {
+            events.emplace_back(std::string(collection) + "/" + std::string(id));
+        }
+        void on_number(std::string_view val) { events.emplace_back("n:" + std::string(val)); }
+        void on_string(std::string_view val) { events.emplace_back("s:" + std::string(val)); }
+        void on_bool(bool val) { events.emplace_back(val ? "true" : "false"); }
+        void on_null() { events.emplace_back("null"); }
+    };
+    
+    Recorder recorder;
+    tyson::TySonParser parser {"m{s|a|:v[n|1|,s|x, y|,],s|b|:m{s|c|:b|true|,s|d|:null,},s|e|:users|e0bb|,}"};
+    parser.walk(recorder);
+    
+    std::vector<std::string> expected {"{", "key:a", "[", "n:1", "s:x, y", "]",
+                                       "key:b", "{", "key:c", "true", "key:d", "null", "}",
+                                       "key:e", "users/e0bb", "}"};
+    ASSERT_EQ(recorder.events, expected);
+}
+
+TEST(tyson_parsing, walk_with_partial_handler)
+{
+    struct Count
+    {
+        int numbers = 0;
+        void on_number(std::string_view) { ++numbers; }
+    };
+    
+    Count count;
+    tyson::TySonParser parser {"v[n|1|,s|2|,v[n|3|,m{s|n|:n|4|,},],]"};
+    parser.walk(count);
+    ASSERT_EQ(count.numbers, 3);
+}
+
+namespace
+{
+    struct WrongParameter
+    {
+        void on_number(long) {}
+    };
+
+    struct MisspelledCallback
+    {
+        void on_strng(std::string_view) {}
+    };
+
+    struct OneWrongCallback
+    {
+        void on_string(std::string_view) {}
+        void on_bool(std::string_view) {}
+    };
+
+    struct OnlyMapEvents
+    {
+        void begin_map() {}
+        void end_map() {}
+    };
+}
+
+TEST(tyson_parsing, walk_handler_callbacks_are_checked)
+{
+    static_assert(!tyson::TySonHandler<WrongParameter>);
+    static_assert(!tyson::TySonHandler<MisspelledCallback>);
+    static_assert(!tyson::TySonHandler<OneWrongCallback>);
+    static_assert(!tyson::TySonHandler<int>);
+    static_assert(tyson::TySonHandler<OnlyMapEvents>);
+}
+
+TEST(tyson_parsing, parse_into_memory_resource)
+{
+    std::array<std::byte, 1 << 14> buffer {};
+    std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    
+    // nothing may fall back to the default resource while parsing
+    auto *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    tyson::TySonObject object {"m{s|a|:v[n|1|,s|a long string which does not fit inline|,],"
+                               "s|b|:m{s|c|:users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,},}", &arena};
+    std::pmr::set_default_resource(previous);
+    
+    ASSERT_EQ(object.get_allocator().resource(), &arena);
+    ASSERT_EQ(object["a"].value().value<tyson::TySonType::Vector>()[1].value<tyson::TySonType::String>(),
+              "a long string which does not fit inline");
+    
+    tyson::TySonObject copy = object;
+    ASSERT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    ASSERT_EQ(copy, object);
+}
+
+TEST(tyson_parsing, create_tyson_floating_number)
+{
+    std::stringstream sstream;
+    auto val = tyson::TySonObject::Number(0.1);
+    
+    ASSERT_EQ(val.type(), tyson::TySonType::Number);
+    ASSERT_EQ(val.value<double>(), 0.1);
+    ASSERT_EQ(val.value<int>(), 0);
+    
+    sstream << val;
+    ASSERT_EQ(sstream.str(), "n|0.1|");
+    ASSERT_EQ(tyson::TySonObject {sstream.str()}, val);
+}
+
+TEST(tyson_parsing, number_limits)
+{
+    tyson::TySonObject big {"n|18446744073709551615|"};
+    ASSERT_EQ(big.value<unsigned long long>(), 18446744073709551615ULL);
+    ASSERT_EQ(big, tyson::TySonObject::Number(18446744073709551615ULL));
+    
+    tyson::TySonObject negative {"n|-9223372036854775808|"};
+    ASSERT_EQ(negative.value<long long>(), INT64_MIN);
+    ASSERT_EQ(negative.value<tyson::TySonType::String>(), "-9223372036854775808");
+    
+    ASSERT_EQ(tyson::TySonObject {"n|5|"}, tyson::TySonObject::Number(5U));
+    ASSERT_EQ(tyson::TySonObject {"n|1e3|"}.value<int>(), 1000);
+}
+
+TEST(tyson_parsing, number_out_of_range)
+{
+    ASSERT_THROW((void) tyson::TySonObject {"n|40000|"}.value<short>(), std::out_of_range);
+    ASSERT_THROW((void) tyson::TySonObject {"n|-1|"}.value<unsigned int>(), std::out_of_range);
+    ASSERT_THROW((void) tyson::TySonObject {"n|18446744073709551615|"}.value<long long>(), std::out_of_range);
+    ASSERT_THROW((void) tyson::TySonObject {"n|3e9|"}.value<int>(), std::out_of_range);
+    ASSERT_THROW((void) tyson::TySonObject {"n|-0.5e20|"}.value<long long>(), std::out_of_range);
+    ASSERT_THROW((void) tyson::TySonObject {"n|1e300|"}.value<float>(), std::out_of_range);
+    
+    ASSERT_EQ(tyson::TySonObject {"n|32767|"}.value<short>(), 32767);
+    ASSERT_EQ(tyson::TySonObject {"n|-2.9|"}.value<int>(), -2);
+    ASSERT_EQ(tyson::TySonObject {"n|-0.5|"}.value<unsigned int>(), 0U);
+    ASSERT_EQ(tyson::TySonObject {"n|-9223372036854775808|"}.value<double>(), -9223372036854775808.0);
+    ASSERT_EQ(tyson::TySonObject {"n|255|"}.value<unsigned char>(), 255);
+}
+
+TEST(tyson_parsing, bool_is_only_true_for_true)
+{
+    ASSERT_TRUE(tyson::TySonObject {"b|true|"}.value<bool>());
+    ASSERT_FALSE(tyson::TySonObject {"b|false|"}.value<bool>());
+    ASSERT_FALSE(tyson::TySonObject {"n|1|"}.value<bool>());
+    ASSERT_EQ(tyson::TySonObject {"b|true|"}.value<int>(), 1);
+}
+
+TEST(tyson_parsing, map_lookup)
+{
+    tyson::TySonObject object {"m{s|b|:n|2|,s|a|:n|1|,s|a|:n|3|,n|1|:s|number key|,}"};
+    
+    ASSERT_EQ(object.value<tyson::TySonType::Map>().size(), 3);
+    ASSERT_EQ(object["a"].value().value<int>(), 1);
+    ASSERT_FALSE(object["missing"].has_value());
+    ASSERT_EQ(object.find("missing"), nullptr);
+    ASSERT_EQ(object.find("b")->value<int>(), 2);
+    ASSERT_EQ(tyson::TySonObject::Number(1).find("a"), nullptr);
+}
+
+TEST(tyson_parsing, at_path)
+{
+    tyson::TySonObject object {"m{s|a|:m{s|b|:v[n|1|,m{s|c|:s|deep|,},],},s|x|:n|5|,}"};
+    
+    ASSERT_EQ(object.at_path("x")->value<int>(), 5);
+    ASSERT_EQ(object.at_path("a.b.0")->value<int>(), 1);
+    ASSERT_EQ(object.at_path("a.b.1.c")->value<tyson::TySonType::String>(), "deep");
+    ASSERT_EQ(object.at_path("a.b")->type(), tyson::TySonType::Vector);
+    ASSERT_EQ(object.at_path("a.b.2"), nullptr);
+    ASSERT_EQ(object.at_path("a.b.c"), nullptr);
+    ASSERT_EQ(object.at_path("a.missing.c"), nullptr);
+    ASSERT_EQ(object.at_path("x.y"), nullptr);
+}
+
+TEST(tyson_parsing, link_uuid)
+{
+    tyson::TySonObject object {"users|e0bbcda2-0911-495e-9f0f-ce00db489f10|"};
+    auto uuid = tyson::Uuid::parse("e0bbcda2-0911-495e-9f0f-ce00db489f10");
+
+    ASSERT_TRUE(uuid.has_value());
+    ASSERT_EQ(object.link_uuid(), uuid);
+    ASSERT_EQ(object.link_collection(), "users");
+    ASSERT_EQ(object, tyson::TySonObject::Link("users", "e0bbcda2-0911-495e-9f0f-ce00db489f10"));
+    ASSERT_EQ(std::hash<tyson::Uuid> {}(*uuid), std::hash<tyson::Uuid> {}(*object.link_uuid()));
+
+    std::stringstream sstream;
+    sstream << object;
+    ASSERT_EQ(sstream.str(), "users|e0bbcda2-0911-495e-9f0f-ce00db489f10|");
+
+    // only lower case uuids are stored binary, everything else stays as it is
+    ASSERT_FALSE(tyson::Uuid::parse("E0BBCDA2-0911-495E-9F0F-CE00DB489F10").has_value());
+    ASSERT_FALSE(tyson::Uuid::parse("e0bbcda2-0911-495e-9f0f-ce00db489f1").has_value());
+    ASSERT_FALSE(tyson::Uuid::parse("e0bbcda2-0911-495e+9f0f-ce00db489f10").has_value());
+
+    auto other = tyson::TySonObject::Link("users", "admin");
+    ASSERT_FALSE(other.link_uuid().has_value());
+    ASSERT_EQ(other.link_collection(), "users");
+    ASSERT_EQ(other.value<tyson::TySonType::Link>().second, "admin");
+}
+
+TEST(tyson_parsing, item_accessors)
+{
+    tyson::TySonObject object {"m{s|b|:v[n|1|,n|2|,],s|a|:s|x|,}"};
+
+    std::vector<std::string> keys;
+    for (const auto &[key, value] : object.map_items())
+    {
+        keys.emplace_back(key.value<tyson::TySonType::String>());
+    }
+    ASSERT_EQ(keys, (std::vector<std::string> {"a", "b"}));
+
+    auto numbers = object.find("b")->vector_items();
+    ASSERT_EQ(numbers.size(), 2);
+    ASSERT_EQ(numbers[1].value<int>(), 2);
+    ASSERT_EQ(numbers.data(), object.at_path("b.0"));
+
+    ASSERT_TRUE(object.vector_items().empty());
+    ASSERT_TRUE(numbers[0].map_items().empty());
+}
+
+TEST(tyson_parsing, writer)
+{
+    std::string raw = "m{s|a|:v[n|1|,n|-2.5|,b|false|,null,keep,],s|b|:m{s|c|:users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,},"
+                      "s|d|:users|admin|,s|e|:utc|1676663200|,}";
+    tyson::TySonObject object {raw};
+    
+    auto written = tyson::Writer::to_string(object);
+    ASSERT_EQ(written, "m{s|a|:v[n|1|,n|-2.5|,b|false|,null,keep,],s|b|:m{s|c|:users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,},"
+                       "s|d|:users|admin|,s|e|:utc|1676663200|,}");
+    ASSERT_EQ(tyson::Writer::size(object), written.size());
+    ASSERT_EQ(written.capacity(), written.size());
+    
+    std::stringstream sstream;
+    sstream << object;
+    ASSERT_EQ(sstream.str(), written);
+    
+    tyson::Writer writer {};
+    writer.begin_map().key("num").number(5).separator().key("list").begin_vector()
+          .string("x").separator().boolean(true).separator().end_vector().separator().end_map();
+    ASSERT_EQ(writer.view(), "m{s|num|:n|5|,s|list|:v[s|x|,b|true|,],}");
+    ASSERT_EQ(tyson::TySonObject {writer.view()}.at_path("list.1")->value<bool>(), true);
+}
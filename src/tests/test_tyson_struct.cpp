@@ -0,0 +1,223 @@
+#include <ranges>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../TySON_struct.hpp"
+#include "../connection.hpp"
+
+
+struct Address
+{
+    std::string city;
+    int zip = 0;
+};
+
+struct User
+{
+    std::string name;
+    long num = 0;
+    double score = 0;
+    bool active = false;
+    std::vector<std::string> tags;
+    std::optional<Address> address;
+    tyson::Uuid friend_id;
+};
+
+template<>
+struct tyson::Describe<Address> : tyson::Fields<tyson::Field<"city", &Address::city>,
+                                                tyson::Field<"zip", &Address::zip>>
+{};
+
+template<>
+struct tyson::Describe<User> : tyson::Fields<tyson::Field<"name", &User::name>,
+                                             tyson::Field<"num", &User::num>,
+                                             tyson::Field<"score", &User::score>,
+                                             tyson::Field<"active", &User::active>,
+                                             tyson::Field<"tags", &User::tags>,
+                                             tyson::Field<"address", &User::address>,
+                                             tyson::Field<"friend", &User::friend_id>>
+{};
+
+TEST(tyson_struct, decode_map)
+{
+    auto user = tyson::decode<User>("m{"
+                                    "s|name|:s|jon, doe|,"
+                                    "s|num|:n|42|,"
+                                    "s|score|:n|1.5|,"
+                                    "s|active|:b|true|,"
+                                    "s|tags|:v[s|a|,s|b|,],"
+                                    "s|address|:m{s|city|:s|Berlin|,s|zip|:n|10115|,},"
+                                    "s|friend|:users|e0bbcda2-0911-495e-9f0f-ce00db489f10|,"
+                                    "s|unknown|:m{s|skipped|:n|1|,},"
+                                    "}");
+    
+    ASSERT_EQ(user.name, "jon, doe");
+    ASSERT_EQ(user.num, 42);
+    ASSERT_EQ(user.score, 1.5);
+    ASSERT_TRUE(user.active);
+    ASSERT_EQ(user.tags, (std::vector<std::string> {"a", "b"}));
+    ASSERT_EQ(user.address->city, "Berlin");
+    ASSERT_EQ(user.address->zip, 10115);
+    ASSERT_EQ(user.friend_id.str(), "e0bbcda2-0911-495e-9f0f-ce00db489f10");
+}
+
+TEST(tyson_struct, missing_and_null_fields)
+{
+    auto user = tyson::decode<User>("m{s|name|:s|jon|,s|address|:null,}");
+    
+    ASSERT_EQ(user.name, "jon");
+    ASSERT_EQ(user.num, 0);
+    ASSERT_FALSE(user.address.has_value());
+    ASSERT_TRUE(user.tags.empty());
+}
+
+TEST(tyson_struct, wrong_types_throw)
+{
+    ASSERT_THROW((void) tyson::decode<User>("m{s|num|:s|42|,}"), std::invalid_argument);
+    ASSERT_THROW((void) tyson::decode<User>("m{s|num|:n|4.2|,}"), std::invalid_argument);
+    ASSERT_THROW((void) tyson::decode<User>("v[]"), std::invalid_argument);
+}
+
+TEST(tyson_struct, decode_response_objects)
+{
+    annadb::Data data {"s|data|:objects{"
+                       "users|d08412fb-9d7e-4d8f-8905-c7355a67ff70|:m{s|name|:s|a|,s|num|:n|1|,},"
+                       "other|d261580c-1c7f-4cf0-a231-be4a25486146|:m{s|name|:s|b|,s|num|:n|2|,},"
+                       "users|2b908538-2ec5-4970-8a65-30f7e3f6302c|:m{s|name|:s|c|,s|num|:n|3|,},"
+                       "}"};
+    
+    auto all = data.decode<User>();
+    ASSERT_EQ(all.size(), 3);
+    ASSERT_EQ(all[1].name, "b");
+    
+    auto users = data.decode<User>("users");
+    ASSERT_EQ(users.size(), 2);
+    ASSERT_EQ(users[0].num + users[1].num, 4);
+    
+    ASSERT_TRUE(annadb::Data {"s|data|:ids[]"}.decode<User>().empty());
+}
+
+struct Record
+{
+    std::string name;
+    long num = 0;
+    double score = 0;
+    bool active = false;
+    std::vector<std::string> tags;
+    std::optional<Address> address;
+};
+
+template<>
+struct tyson::Describe<Record> : tyson::Fields<tyson::Field<"name", &Record::name>,
+                                               tyson::Field<"num", &Record::num>,
+                                               tyson::Field<"score", &Record::score>,
+                                               tyson::Field<"active", &Record::active>,
+                                               tyson::Field<"tags", &Record::tags>,
+                                               tyson::Field<"address", &Record::address>>
+{};
+
+TEST(tyson_struct, encode_struct)
+{
+    Record record {"jon", -3, 0.5, true, {"a", "b"}, Address {"Berlin", 10115}};
+    auto raw = tyson::encode(record);
+    
+    ASSERT_EQ((tyson::Field<"name", &Record::name>::key), "s|name|:");
+    ASSERT_EQ(raw, "m{s|name|:s|jon|,s|num|:n|-3|,s|score|:n|0.5|,s|active|:b|true|,s|tags|:v[s|a|,s|b|,],"
+                   "s|address|:m{s|city|:s|Berlin|,s|zip|:n|10115|,},}");
+    
+    // the encoded struct is valid TySON and decodes to the same values
+    ASSERT_EQ(tyson::TySonObject {raw}.find("num")->value<long>(), -3);
+    auto decoded = tyson::decode<Record>(raw);
+    ASSERT_EQ(decoded.tags, record.tags);
+    ASSERT_EQ(decoded.address->zip, 10115);
+    
+    ASSERT_EQ(tyson::encode(Record {}), "m{s|name|:s||,s|num|:n|0|,s|score|:n|0|,s|active|:b|false|,s|tags|:v[],"
+                                        "s|address|:null,}");
+}
+
+TEST(tyson_struct, insert_structs)
+{
+    std::vector<Address> addresses {{"Berlin", 10115}, {"Hamburg", 20095}};
+    
+    std::stringstream sstream;
+    auto query = annadb::Query::Query("test");
+    query.insert(std::span<const Address> {addresses});
+    sstream << query;
+    
+    ASSERT_EQ(sstream.str(), "collection|test|:insert["
+                             "m{s|city|:s|Berlin|,s|zip|:n|10115|,},"
+                             "m{s|city|:s|Hamburg|,s|zip|:n|20095|,},"
+                             "];");
+    
+    // the encoded records become the written query
+    auto written = std::move(query).write();
+    ASSERT_EQ(written.view(), sstream.str());
+    
+    // an Insert created on its own is copied behind the beginning of the query
+    annadb::Query::Insert insert {std::span<const Address> {addresses}};
+    auto other = annadb::Query::Query("other");
+    other.insert(insert);
+    ASSERT_EQ(std::move(other).write().view(), "collection|other|:insert["
+                                                "m{s|city|:s|Berlin|,s|zip|:n|10115|,},"
+                                                "m{s|city|:s|Hamburg|,s|zip|:n|20095|,},"
+                                                "];");
+}
+
+TEST(tyson_struct, insert_input_range)
+{
+    // a single pass range like a file reader, the records are encoded while it is read
+    std::istringstream zips {"10115 20095"};
+    auto addresses = std::views::istream<int>(zips)
+                     | std::views::transform([](int zip) { return Address {"city_" + std::to_string(zip), zip}; });
+    
+    std::stringstream sstream;
+    auto query = annadb::Query::Query("test");
+    query.insert(addresses);
+    sstream << query;
+    
+    ASSERT_EQ(sstream.str(), "collection|test|:insert["
+                             "m{s|city|:s|city_10115|,s|zip|:n|10115|,},"
+                             "m{s|city|:s|city_20095|,s|zip|:n|20095|,},"
+                             "];");
+    
+    // the buffer the records were encoded into is handed over, nothing stays behind in the query
+    ASSERT_EQ(std::move(query).write().view(), sstream.str());
+    ASSERT_EQ(std::move(query).write().view(), "collection|test|:insert[];");
+    
+    std::istringstream more_zips {"10115"};
+    auto built = annadb::Query::Pipeline("test")
+                 .insert(std::views::istream<int>(more_zips)
+                         | std::views::transform([](int zip) { return Address {"Berlin", zip}; }))
+                 .build();
+    ASSERT_EQ(std::move(built).write().view(), "collection|test|:insert[m{s|city|:s|Berlin|,s|zip|:n|10115|,},];");
+    
+    const std::vector<tyson::TySonObject> numbers {tyson::TySonObject::Number(1), tyson::TySonObject::String("foo")};
+    auto pipeline = annadb::Query::Pipeline("test").insert(numbers).build();
+    sstream.str("");
+    sstream << pipeline;
+    ASSERT_EQ(sstream.str(), "collection|test|:insert[n|1|,s|foo|,];");
+    
+    std::vector<Address> empty {};
+    auto empty_query = annadb::Query::Query("test");
+    empty_query.insert(empty);
+    sstream.str("");
+    sstream << empty_query;
+    ASSERT_EQ(sstream.str(), "collection|test|:insert[];");
+}
+
+TEST(tyson_struct, insert_message_takes_the_written_query)
+{
+    std::vector<Address> addresses {{"Berlin", 10115}, {"Hamburg", 20095}};
+    auto query = annadb::Query::Query("test");
+    query.insert(addresses);
+    
+    // the written buffer becomes the message without being copied or reallocated
+    auto written = std::move(query).write();
+    const auto *data = written.view().data();
+    auto message = annadb::AnnaDB::message(std::move(written));
+    
+    ASSERT_EQ(message.data(), data);
+    ASSERT_EQ(message.to_string(), "collection|test|:insert["
+                                   "m{s|city|:s|Berlin|,s|zip|:n|10115|,},"
+                                   "m{s|city|:s|Hamburg|,s|zip|:n|20095|,},"
+                                   "];");
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "../TySON_view.hpp"
+#include "../connection.hpp"
+
+
+TEST(tyson_view, scalar_view)
+{
+    std::string raw = "n|10.5|";
+    auto view = tyson::TySonView::parse(raw);
+    
+    ASSERT_EQ(view.type(), tyson::TySonType::Number);
+    ASSERT_EQ(view.scalar().value(), "10.5");
+    ASSERT_DOUBLE_EQ(view.scalar().value<double>(), 10.5);
+    ASSERT_EQ(tyson::TySonView::parse("n|10|").scalar().value<int>(), 10);
+    ASSERT_EQ(view.raw().data(), raw.data());
+    
+    ASSERT_THROW([&view]() { return view.link(); }(), std::invalid_argument);
+    ASSERT_THROW([]() { return tyson::TySonView::parse("s|foo|").scalar().value<int>(); }(), std::invalid_argument);
+    
+    // the whole number must be parsed, as tyson::decode does
+    ASSERT_THROW((void)view.scalar().value<int>(), std::invalid_argument);
+    ASSERT_THROW((void)tyson::TySonView::parse("n|12abc|").scalar().value<int>(), std::invalid_argument);
+    ASSERT_THROW((void)tyson::TySonView::parse("n|300|").scalar().value<std::int8_t>(), std::out_of_range);
+}
+
+TEST(tyson_view, link_view)
+{
+    auto view = tyson::TySonView::parse("users|e0bbcda2-0911-495e-9f0f-ce00db489f10|");
+    
+    ASSERT_EQ(view.type(), tyson::TySonType::Link);
+    ASSERT_EQ(view.link().collection(), "users");
+    ASSERT_EQ(view.link().id(), "e0bbcda2-0911-495e-9f0f-ce00db489f10");
+    ASSERT_EQ(view.to_owned(), tyson::TySonObject::Link("users", "e0bbcda2-0911-495e-9f0f-ce00db489f10"));
+}
+
+TEST(tyson_view, vector_view)
+{
+    auto view = tyson::TySonView::parse("v[n|1|,s|a, b|,v[n|2|,],]");
+    
+    ASSERT_EQ(view.type(), tyson::TySonType::Vector);
+    
+    auto vector = view.vector();
+    ASSERT_EQ(vector.size(), 3);
+    
+    std::vector<tyson::TySonType> types {};
+    for (const auto &element : vector)
+    {
+        types.emplace_back(element.type());
+    }
+    
+    std::vector<tyson::TySonType> expected {tyson::TySonType::Number, tyson::TySonType::String, tyson::TySonType::Vector};
+    ASSERT_EQ(types, expected);
+    ASSERT_EQ(vector.to_owned(), tyson::TySonObject("v[n|1|,s|a, b|,v[n|2|,],]"));
+}
+
+TEST(tyson_view, map_view)
+{
+    auto view = tyson::TySonView::parse("m{s|name|:s|test|,s|inner|:m{s|num|:n|1|,},}");
+    
+    ASSERT_EQ(view.type(), tyson::TySonType::Map);
+    
+    auto map = view.map();
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map["name"].value().scalar().value(), "test");
+    ASSERT_EQ(map["inner"].value().map()["num"].value().scalar().value<int>(), 1);
+    ASSERT_FALSE(map["missing"].has_value());
+    
+    ASSERT_EQ(map.to_owned(), tyson::TySonObject("m{s|name|:s|test|,s|inner|:m{s|num|:n|1|,},}"));
+}
+
+TEST(tyson_view, journal_data_views)
+{
+    annadb::Journal journal {"result:ok[response{s|data|:objects{"
+                             "test|d08412fb-9d7e-4d8f-8905-c7355a67ff70|:m{s|num|:n|0|,},"
+                             "test|d261580c-1c7f-4cf0-a231-be4a25486146|:m{s|num|:n|1|,},"
+                             "},s|meta|:find_meta{s|count|:n|2|,},},];"};
+    ASSERT_TRUE(journal.ok());
+    
+    auto objects = journal.data().view<tyson::TySonType::Objects>();
+    ASSERT_TRUE(objects.has_value());
+    
+    int sum = 0;
+    for (const auto &[link, value] : objects.value())
+    {
+        ASSERT_EQ(link.link().collection(), "test");
+        sum += value.map()["num"].value().scalar().value<int>();
+    }
+    ASSERT_EQ(sum, 1);
+    ASSERT_FALSE(journal.data().view<tyson::TySonType::IDs>().has_value());
+}
+
+TEST(tyson_view, shared_buffer_outlives_source)
+{
+    std::optional<annadb::Data> data {};
+    {
+        std::string response = "s|data|:ids[test|4339ace2-9ab3-4c79-b557-f9b78d66b7f9|,"
+                               "test|3677c916-ac4d-40ab-89f4-def1e565e7ab|,]";
+        data.emplace(response);
+    }
+    
+    auto ids = data.value().view<tyson::TySonType::IDs>();
+    ASSERT_TRUE(ids.has_value());
+    ASSERT_EQ(ids.value().size(), 2);
+    ASSERT_EQ((*ids.value().begin()).link().id(), "4339ace2-9ab3-4c79-b557-f9b78d66b7f9");
+}
@@ -9,6 +9,7 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <cctype>
 #include <iostream>
 
 namespace utils
@@ -23,11 +24,10 @@ namespace utils
      */
     inline std::vector<std::string> split(std::string_view txt, char delim) noexcept
     {   const auto to_string = [](auto && chr) -> std::string {
-            const std::ranges::common_view cv = std::ranges::common_view{chr};
-            return {cv.begin(), cv.end()};
+            return {chr.begin(), chr.end()};
         };
 
-        const auto range_ = std::ranges::split_view(txt, delim) | std::ranges::views::transform(to_string);
+        auto range_ = std::ranges::split_view(txt, delim) | std::ranges::views::transform(to_string);
 
         std::vector<std::string> vec;
         vec.reserve(std::distance(range_.begin(), range_.end()));
@@ -36,5 +36,26 @@ namespace utils
         
         return vec;
     }
+
+    /**
+     * Helper to remove leading and trailing whitespace without copying
+     *
+     * @param txt original string
+     * @return the part of txt without surrounding whitespace
+     */
+    inline std::string_view trim(std::string_view txt) noexcept
+    {
+        const auto is_space = [](char chr) { return std::isspace(static_cast<unsigned char>(chr)) != 0; };
+
+        while (!txt.empty() && is_space(txt.front()))
+        {
+            txt.remove_prefix(1);
+        }
+        while (!txt.empty() && is_space(txt.back()))
+        {
+            txt.remove_suffix(1);
+        }
+        return txt;
+    }
 }
 #endif //ANNADB_DRIVER_UTILS_HPP